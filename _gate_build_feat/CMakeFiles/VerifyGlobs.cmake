@@ -0,0 +1,111 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by CMake Version 3.25
+cmake_policy(SET CMP0009 NEW)
+
+# infomap_sources at CMakeLists.txt:105 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/src/*.cpp")
+set(OLD_GLOB
+  "/root/repo/src/core/BiasedMapEquation.cpp"
+  "/root/repo/src/core/InfoEdge.cpp"
+  "/root/repo/src/core/InfoNode.cpp"
+  "/root/repo/src/core/InfomapBase.cpp"
+  "/root/repo/src/core/LossyMapEquation.cpp"
+  "/root/repo/src/core/MemMapEquation.cpp"
+  "/root/repo/src/core/MetaMapEquation.cpp"
+  "/root/repo/src/core/RegularizedMultilayerMapEquation.cpp"
+  "/root/repo/src/core/StateNetwork.cpp"
+  "/root/repo/src/core/iterators/InfomapIterator.cpp"
+  "/root/repo/src/io/ClusterMap.cpp"
+  "/root/repo/src/io/Config.cpp"
+  "/root/repo/src/io/FlowCache.cpp"
+  "/root/repo/src/io/Network.cpp"
+  "/root/repo/src/io/NetworkBuilder.cpp"
+  "/root/repo/src/io/Output.cpp"
+  "/root/repo/src/io/OutputFormats.cpp"
+  "/root/repo/src/io/OutputPlan.cpp"
+  "/root/repo/src/io/OutputView.cpp"
+  "/root/repo/src/io/ParameterCatalog.cpp"
+  "/root/repo/src/io/ProgramInterface.cpp"
+  "/root/repo/src/io/RunMetadata.cpp"
+  "/root/repo/src/io/RunReport.cpp"
+  "/root/repo/src/io/TrialResults.cpp"
+  "/root/repo/src/main.cpp"
+  "/root/repo/src/utils/Console.cpp"
+  "/root/repo/src/utils/FileURI.cpp"
+  "/root/repo/src/utils/FlowCalculator.cpp"
+  "/root/repo/src/utils/Log.cpp"
+  "/root/repo/src/utils/MemoryUsage.cpp"
+  "/root/repo/src/utils/ThreadConfig.cpp"
+  "/root/repo/src/utils/convert.cpp"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_gate_build_feat/CMakeFiles/cmake.verify_globs")
+endif()
+
+# infomap_headers at CMakeLists.txt:104 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/src/*.h")
+set(OLD_GLOB
+  "/root/repo/src/Infomap.h"
+  "/root/repo/src/core/BiasedMapEquation.h"
+  "/root/repo/src/core/FlowData.h"
+  "/root/repo/src/core/InfoEdge.h"
+  "/root/repo/src/core/InfoNode.h"
+  "/root/repo/src/core/InfomapBase.h"
+  "/root/repo/src/core/InfomapConfig.h"
+  "/root/repo/src/core/InfomapOptimizer.h"
+  "/root/repo/src/core/InfomapOptimizerBase.h"
+  "/root/repo/src/core/LossyMapEquation.h"
+  "/root/repo/src/core/MapEquation.h"
+  "/root/repo/src/core/MemMapEquation.h"
+  "/root/repo/src/core/MetaMapEquation.h"
+  "/root/repo/src/core/ObjectPool.h"
+  "/root/repo/src/core/RegularizedMultilayerMapEquation.h"
+  "/root/repo/src/core/StateNetwork.h"
+  "/root/repo/src/core/iterators/InfomapIterator.h"
+  "/root/repo/src/core/iterators/IterWrapper.h"
+  "/root/repo/src/core/iterators/infomapIterators.h"
+  "/root/repo/src/core/iterators/treeIterators.h"
+  "/root/repo/src/io/ClusterMap.h"
+  "/root/repo/src/io/Config.h"
+  "/root/repo/src/io/Features.h"
+  "/root/repo/src/io/FlowCache.h"
+  "/root/repo/src/io/InfomapError.h"
+  "/root/repo/src/io/JsonNetworkInputParser.h"
+  "/root/repo/src/io/Network.h"
+  "/root/repo/src/io/NetworkBuilder.h"
+  "/root/repo/src/io/NetworkInputParser.h"
+  "/root/repo/src/io/Output.h"
+  "/root/repo/src/io/OutputFormats.h"
+  "/root/repo/src/io/OutputPlan.h"
+  "/root/repo/src/io/OutputView.h"
+  "/root/repo/src/io/ParameterCatalog.h"
+  "/root/repo/src/io/ParsedOption.h"
+  "/root/repo/src/io/ProgramInterface.h"
+  "/root/repo/src/io/RunMetadata.h"
+  "/root/repo/src/io/RunReport.h"
+  "/root/repo/src/io/SafeFile.h"
+  "/root/repo/src/io/TrialResults.h"
+  "/root/repo/src/utils/Console.h"
+  "/root/repo/src/utils/Date.h"
+  "/root/repo/src/utils/FileURI.h"
+  "/root/repo/src/utils/FlowCalculator.h"
+  "/root/repo/src/utils/Log.h"
+  "/root/repo/src/utils/MemoryUsage.h"
+  "/root/repo/src/utils/MetaCollection.h"
+  "/root/repo/src/utils/Random.h"
+  "/root/repo/src/utils/Stopwatch.h"
+  "/root/repo/src/utils/ThreadConfig.h"
+  "/root/repo/src/utils/TimingRegistry.h"
+  "/root/repo/src/utils/VectorMap.h"
+  "/root/repo/src/utils/convert.h"
+  "/root/repo/src/utils/format.h"
+  "/root/repo/src/utils/format_core.h"
+  "/root/repo/src/utils/formatters.h"
+  "/root/repo/src/utils/infomath.h"
+  "/root/repo/src/version.h"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_gate_build_feat/CMakeFiles/cmake.verify_globs")
+endif()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/infomap_cli.dir/src/main.cpp.o"
+  "CMakeFiles/infomap_cli.dir/src/main.cpp.o.d"
+  "Infomap"
+  "Infomap.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/infomap_cli.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
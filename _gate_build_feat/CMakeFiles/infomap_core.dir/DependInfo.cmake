@@ -0,0 +1,49 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/core/BiasedMapEquation.cpp" "CMakeFiles/infomap_core.dir/src/core/BiasedMapEquation.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/BiasedMapEquation.cpp.o.d"
+  "/root/repo/src/core/InfoEdge.cpp" "CMakeFiles/infomap_core.dir/src/core/InfoEdge.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/InfoEdge.cpp.o.d"
+  "/root/repo/src/core/InfoNode.cpp" "CMakeFiles/infomap_core.dir/src/core/InfoNode.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/InfoNode.cpp.o.d"
+  "/root/repo/src/core/InfomapBase.cpp" "CMakeFiles/infomap_core.dir/src/core/InfomapBase.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/InfomapBase.cpp.o.d"
+  "/root/repo/src/core/LossyMapEquation.cpp" "CMakeFiles/infomap_core.dir/src/core/LossyMapEquation.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/LossyMapEquation.cpp.o.d"
+  "/root/repo/src/core/MemMapEquation.cpp" "CMakeFiles/infomap_core.dir/src/core/MemMapEquation.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/MemMapEquation.cpp.o.d"
+  "/root/repo/src/core/MetaMapEquation.cpp" "CMakeFiles/infomap_core.dir/src/core/MetaMapEquation.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/MetaMapEquation.cpp.o.d"
+  "/root/repo/src/core/RegularizedMultilayerMapEquation.cpp" "CMakeFiles/infomap_core.dir/src/core/RegularizedMultilayerMapEquation.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/RegularizedMultilayerMapEquation.cpp.o.d"
+  "/root/repo/src/core/StateNetwork.cpp" "CMakeFiles/infomap_core.dir/src/core/StateNetwork.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/StateNetwork.cpp.o.d"
+  "/root/repo/src/core/iterators/InfomapIterator.cpp" "CMakeFiles/infomap_core.dir/src/core/iterators/InfomapIterator.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/core/iterators/InfomapIterator.cpp.o.d"
+  "/root/repo/src/io/ClusterMap.cpp" "CMakeFiles/infomap_core.dir/src/io/ClusterMap.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/ClusterMap.cpp.o.d"
+  "/root/repo/src/io/Config.cpp" "CMakeFiles/infomap_core.dir/src/io/Config.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/Config.cpp.o.d"
+  "/root/repo/src/io/FlowCache.cpp" "CMakeFiles/infomap_core.dir/src/io/FlowCache.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/FlowCache.cpp.o.d"
+  "/root/repo/src/io/Network.cpp" "CMakeFiles/infomap_core.dir/src/io/Network.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/Network.cpp.o.d"
+  "/root/repo/src/io/NetworkBuilder.cpp" "CMakeFiles/infomap_core.dir/src/io/NetworkBuilder.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/NetworkBuilder.cpp.o.d"
+  "/root/repo/src/io/Output.cpp" "CMakeFiles/infomap_core.dir/src/io/Output.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/Output.cpp.o.d"
+  "/root/repo/src/io/OutputFormats.cpp" "CMakeFiles/infomap_core.dir/src/io/OutputFormats.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/OutputFormats.cpp.o.d"
+  "/root/repo/src/io/OutputPlan.cpp" "CMakeFiles/infomap_core.dir/src/io/OutputPlan.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/OutputPlan.cpp.o.d"
+  "/root/repo/src/io/OutputView.cpp" "CMakeFiles/infomap_core.dir/src/io/OutputView.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/OutputView.cpp.o.d"
+  "/root/repo/src/io/ParameterCatalog.cpp" "CMakeFiles/infomap_core.dir/src/io/ParameterCatalog.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/ParameterCatalog.cpp.o.d"
+  "/root/repo/src/io/ProgramInterface.cpp" "CMakeFiles/infomap_core.dir/src/io/ProgramInterface.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/ProgramInterface.cpp.o.d"
+  "/root/repo/src/io/RunMetadata.cpp" "CMakeFiles/infomap_core.dir/src/io/RunMetadata.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/RunMetadata.cpp.o.d"
+  "/root/repo/src/io/RunReport.cpp" "CMakeFiles/infomap_core.dir/src/io/RunReport.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/RunReport.cpp.o.d"
+  "/root/repo/src/io/TrialResults.cpp" "CMakeFiles/infomap_core.dir/src/io/TrialResults.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/io/TrialResults.cpp.o.d"
+  "/root/repo/src/utils/Console.cpp" "CMakeFiles/infomap_core.dir/src/utils/Console.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/utils/Console.cpp.o.d"
+  "/root/repo/src/utils/FileURI.cpp" "CMakeFiles/infomap_core.dir/src/utils/FileURI.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/utils/FileURI.cpp.o.d"
+  "/root/repo/src/utils/FlowCalculator.cpp" "CMakeFiles/infomap_core.dir/src/utils/FlowCalculator.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/utils/FlowCalculator.cpp.o.d"
+  "/root/repo/src/utils/Log.cpp" "CMakeFiles/infomap_core.dir/src/utils/Log.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/utils/Log.cpp.o.d"
+  "/root/repo/src/utils/MemoryUsage.cpp" "CMakeFiles/infomap_core.dir/src/utils/MemoryUsage.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/utils/MemoryUsage.cpp.o.d"
+  "/root/repo/src/utils/ThreadConfig.cpp" "CMakeFiles/infomap_core.dir/src/utils/ThreadConfig.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/utils/ThreadConfig.cpp.o.d"
+  "/root/repo/src/utils/convert.cpp" "CMakeFiles/infomap_core.dir/src/utils/convert.cpp.o" "gcc" "CMakeFiles/infomap_core.dir/src/utils/convert.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,71 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/infomap_core.dir/src/core/BiasedMapEquation.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/BiasedMapEquation.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/core/InfoEdge.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/InfoEdge.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/core/InfoNode.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/InfoNode.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/core/InfomapBase.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/InfomapBase.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/core/LossyMapEquation.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/LossyMapEquation.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/core/MemMapEquation.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/MemMapEquation.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/core/MetaMapEquation.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/MetaMapEquation.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/core/RegularizedMultilayerMapEquation.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/RegularizedMultilayerMapEquation.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/core/StateNetwork.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/StateNetwork.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/core/iterators/InfomapIterator.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/core/iterators/InfomapIterator.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/ClusterMap.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/ClusterMap.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/Config.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/Config.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/FlowCache.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/FlowCache.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/Network.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/Network.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/NetworkBuilder.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/NetworkBuilder.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/Output.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/Output.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/OutputFormats.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/OutputFormats.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/OutputPlan.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/OutputPlan.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/OutputView.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/OutputView.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/ParameterCatalog.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/ParameterCatalog.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/ProgramInterface.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/ProgramInterface.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/RunMetadata.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/RunMetadata.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/RunReport.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/RunReport.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/io/TrialResults.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/io/TrialResults.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/utils/Console.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/utils/Console.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/utils/FileURI.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/utils/FileURI.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/utils/FlowCalculator.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/utils/FlowCalculator.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/utils/Log.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/utils/Log.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/utils/MemoryUsage.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/utils/MemoryUsage.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/utils/ThreadConfig.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/utils/ThreadConfig.cpp.o.d"
+  "CMakeFiles/infomap_core.dir/src/utils/convert.cpp.o"
+  "CMakeFiles/infomap_core.dir/src/utils/convert.cpp.o.d"
+  "libinfomap_core.a"
+  "libinfomap_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/infomap_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/cpp/doctest_main.cpp" "CMakeFiles/infomap_cpp_config_tests.dir/test/cpp/doctest_main.cpp.o" "gcc" "CMakeFiles/infomap_cpp_config_tests.dir/test/cpp/doctest_main.cpp.o.d"
+  "/root/repo/test/cpp/test_config.cpp" "CMakeFiles/infomap_cpp_config_tests.dir/test/cpp/test_config.cpp.o" "gcc" "CMakeFiles/infomap_cpp_config_tests.dir/test/cpp/test_config.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build_feat/CMakeFiles/infomap_core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/infomap_cpp_map_equation_invariants_tests.dir/test/cpp/doctest_main.cpp.o"
+  "CMakeFiles/infomap_cpp_map_equation_invariants_tests.dir/test/cpp/doctest_main.cpp.o.d"
+  "CMakeFiles/infomap_cpp_map_equation_invariants_tests.dir/test/cpp/test_map_equation_invariants.cpp.o"
+  "CMakeFiles/infomap_cpp_map_equation_invariants_tests.dir/test/cpp/test_map_equation_invariants.cpp.o.d"
+  "infomap_cpp_map_equation_invariants_tests"
+  "infomap_cpp_map_equation_invariants_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/infomap_cpp_map_equation_invariants_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
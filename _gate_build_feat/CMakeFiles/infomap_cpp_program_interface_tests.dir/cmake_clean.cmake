@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/infomap_cpp_program_interface_tests.dir/test/cpp/doctest_main.cpp.o"
+  "CMakeFiles/infomap_cpp_program_interface_tests.dir/test/cpp/doctest_main.cpp.o.d"
+  "CMakeFiles/infomap_cpp_program_interface_tests.dir/test/cpp/test_program_interface.cpp.o"
+  "CMakeFiles/infomap_cpp_program_interface_tests.dir/test/cpp/test_program_interface.cpp.o.d"
+  "infomap_cpp_program_interface_tests"
+  "infomap_cpp_program_interface_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/infomap_cpp_program_interface_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/infomap_cpp_tests"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/infomap_cpp_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
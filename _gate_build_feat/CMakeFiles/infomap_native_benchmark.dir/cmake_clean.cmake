@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/infomap_native_benchmark.dir/test/bench/native_benchmark.cpp.o"
+  "CMakeFiles/infomap_native_benchmark.dir/test/bench/native_benchmark.cpp.o.d"
+  "infomap_native_benchmark"
+  "infomap_native_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/infomap_native_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,58 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_build_feat
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[infomap_cpp_network_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_network_tests")
+set_tests_properties([=[infomap_cpp_network_tests]=] PROPERTIES  LABELS "fast;core;network;parser" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;187;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_lifecycle_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_lifecycle_tests")
+set_tests_properties([=[infomap_cpp_lifecycle_tests]=] PROPERTIES  LABELS "fast;core;lifecycle;crash" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;188;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_partition_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_partition_tests")
+set_tests_properties([=[infomap_cpp_partition_tests]=] PROPERTIES  LABELS "fast;core;partition;parser" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;189;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_flow_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_flow_tests")
+set_tests_properties([=[infomap_cpp_flow_tests]=] PROPERTIES  LABELS "fast;core;flow" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;190;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_utils_io_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_utils_io_tests")
+set_tests_properties([=[infomap_cpp_utils_io_tests]=] PROPERTIES  LABELS "fast;core;utils;io" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;191;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_program_interface_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_program_interface_tests")
+set_tests_properties([=[infomap_cpp_program_interface_tests]=] PROPERTIES  LABELS "fast;core;parser;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;192;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_config_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_config_tests")
+set_tests_properties([=[infomap_cpp_config_tests]=] PROPERTIES  LABELS "fast;core;config;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;193;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_thread_config_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_thread_config_tests")
+set_tests_properties([=[infomap_cpp_thread_config_tests]=] PROPERTIES  LABELS "fast;core;threads" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;194;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_no_output_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_no_output_tests")
+set_tests_properties([=[infomap_cpp_no_output_tests]=] PROPERTIES  LABELS "fast;core;output;library" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;195;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_trial_results_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_trial_results_tests")
+set_tests_properties([=[infomap_cpp_trial_results_tests]=] PROPERTIES  LABELS "fast;core;merge" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;196;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_output_view_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_output_view_tests")
+set_tests_properties([=[infomap_cpp_output_view_tests]=] PROPERTIES  LABELS "fast;core;output" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;197;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_object_pool_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_object_pool_tests")
+set_tests_properties([=[infomap_cpp_object_pool_tests]=] PROPERTIES  LABELS "fast;core;memory" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;198;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_lossy_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_lossy_tests")
+set_tests_properties([=[infomap_cpp_lossy_tests]=] PROPERTIES  LABELS "fast;core;lossy" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;199;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_preferred_levels_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_preferred_levels_tests")
+set_tests_properties([=[infomap_cpp_preferred_levels_tests]=] PROPERTIES  LABELS "fast;core;preferred-levels" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;200;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_random_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_random_tests")
+set_tests_properties([=[infomap_cpp_random_tests]=] PROPERTIES  LABELS "fast;core;rng" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;201;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[infomap_cpp_map_equation_invariants_tests]=] "/root/repo/_gate_build_feat/infomap_cpp_map_equation_invariants_tests")
+set_tests_properties([=[infomap_cpp_map_equation_invariants_tests]=] PROPERTIES  LABELS "fast;core;mapeq" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;183;add_test;/root/repo/CMakeLists.txt;202;add_infomap_cpp_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[print_json_parameters]=] "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_print_json_parameters.py" "/root/repo/_gate_build_feat/Infomap")
+set_tests_properties([=[print_json_parameters]=] PROPERTIES  LABELS "fast;core;parser;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;204;add_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[binding_defaults]=] "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_binding_defaults.py" "/root/repo/_gate_build_feat/Infomap")
+set_tests_properties([=[binding_defaults]=] PROPERTIES  LABELS "fast;core;parser;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;213;add_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[shell_completion]=] "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_shell_completion.py" "/root/repo/_gate_build_feat/Infomap")
+set_tests_properties([=[shell_completion]=] PROPERTIES  LABELS "fast;core;parser;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;222;add_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[interrupted_artifact]=] "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_interrupted_artifact.py" "/root/repo/_gate_build_feat/Infomap")
+set_tests_properties([=[interrupted_artifact]=] PROPERTIES  LABELS "core;cli;crash" SKIP_RETURN_CODE "77" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;231;add_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[help_contract]=] "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_help_contract.py" "/root/repo/_gate_build_feat/Infomap")
+set_tests_properties([=[help_contract]=] PROPERTIES  LABELS "fast;core;parser;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;241;add_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[pretty_output]=] "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_pretty_output.py" "/root/repo/_gate_build_feat/Infomap" "/root/repo")
+set_tests_properties([=[pretty_output]=] PROPERTIES  LABELS "fast;core;output;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;250;add_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[run_metadata_cli]=] "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_run_metadata_cli.py" "/root/repo/_gate_build_feat/Infomap")
+set_tests_properties([=[run_metadata_cli]=] PROPERTIES  LABELS "fast;core;output;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;260;add_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[run_reports_cli]=] "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_run_reports_cli.py" "/root/repo/_gate_build_feat/Infomap")
+set_tests_properties([=[run_reports_cli]=] PROPERTIES  LABELS "fast;core;output;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[trial_results_cli]=] "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_trial_results_cli.py" "/root/repo/_gate_build_feat/Infomap")
+set_tests_properties([=[trial_results_cli]=] PROPERTIES  LABELS "fast;core;merge;cli" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;278;add_test;/root/repo/CMakeLists.txt;0;")
+add_test([=[js_output_format_manifest]=] "/usr/bin/cmake" "-E" "env" "CXX=/usr/bin/c++" "/root/.pyenv/shims/python3" "/root/repo/test/scripts/check_js_output_formats.py" "/root/repo/src/io/OutputFormats.cpp" "/root/repo/interfaces/js/generated/output-formats.json")
+set_tests_properties([=[js_output_format_manifest]=] PROPERTIES  LABELS "fast;core;output;js" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;287;add_test;/root/repo/CMakeLists.txt;0;")
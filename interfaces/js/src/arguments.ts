@@ -62,6 +62,11 @@ export type Arguments = Partial<{
   maxFlowIterations: number;
   minFlowIterations: number;
   flowTolerance: number;
+  flowAcceleration:
+    | "none"
+    | "quadratic";
+  flowCache: string;
+  initialFlow: string;
   regularized: boolean;
   regularizationStrength: number;
   entropyCorrected: boolean;
@@ -88,6 +93,8 @@ export type Arguments = Partial<{
   coreLoopCodelengthThreshold: number;
   tuneIterationRelativeThreshold: number;
   fastHierarchicalSolution: 1 | 2 | 3;
+  activeSet: boolean;
+  exactSmallModules: boolean;
   converge: boolean;
   preferModularSolution: boolean;
   numRandomMoves: number;
@@ -223,6 +230,19 @@ export default function argumentsToString(args: Arguments) {
   if (args.flowTolerance != null)
     result += " --flow-tolerance " + args.flowTolerance;
 
+  if (args.flowAcceleration != null)
+    result +=
+      " --flow-acceleration " +
+      requireNoWhitespace("flowAcceleration", args.flowAcceleration);
+
+  if (args.flowCache != null)
+    result +=
+      " --flow-cache " + requireNoWhitespace("flowCache", args.flowCache);
+
+  if (args.initialFlow != null)
+    result +=
+      " --initial-flow " + requireNoWhitespace("initialFlow", args.initialFlow);
+
   if (args.regularized) result += " --regularized";
 
   if (args.regularizationStrength != null)
@@ -296,6 +316,10 @@ export default function argumentsToString(args: Arguments) {
   if (args.fastHierarchicalSolution)
     result += " -" + "F".repeat(args.fastHierarchicalSolution);
 
+  if (args.activeSet) result += " --active-set";
+
+  if (args.exactSmallModules) result += " --exact-small-modules";
+
   if (args.converge) result += " --converge";
 
   if (args.preferModularSolution) result += " --prefer-modular-solution";
@@ -37,8 +37,10 @@ from ._options import (
     _UNSET,
     # The Literal aliases are referenced by the generated __init__/run
     # signatures below, which are evaluated at class-definition time.
+    FlowAcceleration,
     FlowModel,
     InfomapOptions,
+    InnerParallelStrategy,
     Options,
     OutputFormat,
     _construct_args,
@@ -267,6 +269,9 @@ class Infomap(_InfomapResultsMixin, _InfomapWritersMixin):
         max_flow_iterations: int = 400,
         min_flow_iterations: int = 50,
         flow_tolerance: float = 1e-15,
+        flow_acceleration: FlowAcceleration | None = None,
+        flow_cache: str | os.PathLike[str] | None = None,
+        initial_flow: str | os.PathLike[str] | None = None,
         regularized: bool = False,
         regularization_strength: float = 1.0,
         entropy_corrected: bool = False,
@@ -293,7 +298,16 @@ class Infomap(_InfomapResultsMixin, _InfomapWritersMixin):
         tune_iteration_relative_threshold: float = 1e-05,
         fast_hierarchical_solution: int | None = None,
         inner_parallelization: bool = False,
+        deterministic: bool = False,
+        inner_parallel_strategy: InnerParallelStrategy | None = None,
+        active_set: bool = False,
+        parallel_fine_tune: bool = False,
+        exact_small_modules: bool = False,
+        partition_task_grain: int = 16,
+        parallel_super_modules: bool = False,
         parallel_trials: bool = False,
+        prune_trials: bool = False,
+        prune_trials_margin: float = 0.02,
         converge: bool = False,
         num_threads: str | int | None = None,
         threads: str | int | None = None,
@@ -630,6 +644,32 @@ class Infomap(_InfomapResultsMixin, _InfomapWritersMixin):
             Iteration stops once the per-iteration change in flow drops to or below this
             value, after --min-flow-iterations have run.
 
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        flow_acceleration : str, optional
+            Accelerate the power iteration used to calculate flow. 'none' runs plain
+            power iteration. 'quadratic' extrapolates from the last four iterates every
+            ten iterations (quadratic extrapolation), which saves the most with a low
+            teleportation probability. The flow is the same within --flow-tolerance.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        flow_cache : str or os.PathLike, optional
+            Keep the calculated flow in this directory and reuse it when the same
+            network is run again with the same flow settings, skipping the flow
+            calculation. Files are named by a hash of the network and the flow settings.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        initial_flow : str or os.PathLike, optional
+            Start the power iteration used to calculate flow from the node flow in a
+            clu, tree or ftree file, such as the output of a run on a previous snapshot
+            of the network. If the file misses nodes, one power iteration from the
+            degrees is taken first, counted in the iterations, and they keep its flow.
+            Applies to directed flow, also with --regularized, but not with
+            --bipartite-teleportation; lower --min-flow-iterations to let a close
+            starting flow stop early.
+
             .. versionchanged:: 2.15
                 Pass it via ``Options``; moves off this signature in 3.0.
         regularized : bool, optional
@@ -778,14 +818,98 @@ class Infomap(_InfomapResultsMixin, _InfomapWritersMixin):
             core-loop-codelength-threshold and low tune-iteration-limit, and may produce
             a different partition than serial optimization.
 
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        deterministic : bool, optional
+            Make parallel optimization independent of the thread count. With
+            --inner-parallelization, large networks always use the parallel move sweep
+            over fixed node blocks with per-block random streams derived from the seed,
+            whatever --num-threads is, and parallel-trial workers keep it. The output is
+            then identical for any --num-threads at a small throughput cost.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        inner_parallel_strategy : str, optional
+            Sweep engine for --inner-parallelization. 'proposals' proposes every move
+            against the sweep-start modules and commits them serially, rechecking moves
+            whose modules changed. Experimental: 'coloring' colors the network so no two
+            linked nodes share a color and moves each color at once without a commit
+            pass; it applies to ordinary networks without recorded teleportation, other
+            objectives use 'proposals'. It has not yet been measured against 'proposals'
+            on several threads, where skipping the commit pass is meant to pay off.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        active_set : bool, optional
+            Keep a queue of the nodes whose neighbourhood changed and sweep only those,
+            in random order, instead of scanning every node for a change in each core
+            loop. Late core loops then cost in proportion to the nodes still moving.
+            Nodes marked during a sweep wait for the next one, so the partition may
+            differ from the default sweep. Applies to the serial and the 'proposals'
+            parallel sweep.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        parallel_fine_tune : bool, optional
+            Fine-tune with the parallel move sweep, also without
+            --inner-parallelization, and revisit only the nodes in or linked to a module
+            that changed since the previous fine-tune. Later tune iterations then cost
+            in proportion to what the coarse tune and the merges changed. Follows
+            --deterministic and --inner-parallel-strategy.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        exact_small_modules : bool, optional
+            In the recursive sub-module search, partition modules of three to eight
+            nodes by trying every way to split them instead of running a sub-Infomap on
+            each. The split with the shortest two-level codelength is kept if it passes
+            the same test a sub-Infomap result would, so such modules always get their
+            optimal split but no super-module level within them.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        partition_task_grain : int, optional
+            Smallest number of nodes the recursive sub-module search hands to one OpenMP
+            task. A module with at least this many nodes gets its own task, smaller ones
+            are batched into one task until their nodes add up to it, and a remainder
+            below it is searched by the task that found the modules. 0 gives every
+            module its own task.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        parallel_super_modules : bool, optional
+            Search for super-modules with the parallel move sweep, also without
+            --inner-parallelization, on super networks large enough for the parallel
+            sweep. Follows --deterministic and --inner-parallel-strategy.
+
             .. versionchanged:: 2.15
                 Pass it via ``Options``; moves off this signature in 3.0.
         parallel_trials : bool, optional
             Run independent trials in parallel with OpenMP. --num-trials remains the
             total number of trials; the number of parallel workers follows the OpenMP
             thread count (e.g. OMP_NUM_THREADS), clamped to --num-trials. Peak memory
-            scales with the worker count. Nested OpenMP and --inner-parallelization are
-            disabled inside workers.
+            scales with the worker count. The OpenMP threads are split evenly over the
+            workers: a worker with more than one thread runs its trials on a nested team
+            of them and keeps --inner-parallelization, and workers still running trials
+            take over the threads of those that are done. With one thread per worker,
+            nesting is off and --inner-parallelization runs single-threaded under
+            --deterministic, or not at all.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        prune_trials : bool, optional
+            With --parallel-trials, abandon a trial whose codelength after the two-level
+            partition is more than --prune-trials-margin above the best two-level
+            codelength so far, or whose codelength after the super-module search is that
+            far above the best finished trial. Abandoned trials are marked in
+            --trial-results. Which trials are abandoned depends on the order they finish
+            in.
+
+            .. versionchanged:: 2.15
+                Pass it via ``Options``; moves off this signature in 3.0.
+        prune_trials_margin : float, optional
+            Relative codelength margin for --prune-trials: a trial is abandoned when its
+            codelength exceeds the best at the same stage by more than this fraction.
 
             .. versionchanged:: 2.15
                 Pass it via ``Options``; moves off this signature in 3.0.
@@ -886,6 +1010,9 @@ class Infomap(_InfomapResultsMixin, _InfomapWritersMixin):
         max_flow_iterations: int = 400,
         min_flow_iterations: int = 50,
         flow_tolerance: float = 1e-15,
+        flow_acceleration: FlowAcceleration | None = None,
+        flow_cache: str | os.PathLike[str] | None = None,
+        initial_flow: str | os.PathLike[str] | None = None,
         regularized: bool = False,
         regularization_strength: float = 1.0,
         entropy_corrected: bool = False,
@@ -912,7 +1039,16 @@ class Infomap(_InfomapResultsMixin, _InfomapWritersMixin):
         tune_iteration_relative_threshold: float = 1e-05,
         fast_hierarchical_solution: int | None = None,
         inner_parallelization: bool = False,
+        deterministic: bool = False,
+        inner_parallel_strategy: InnerParallelStrategy | None = None,
+        active_set: bool = False,
+        parallel_fine_tune: bool = False,
+        exact_small_modules: bool = False,
+        partition_task_grain: int = 16,
+        parallel_super_modules: bool = False,
         parallel_trials: bool = False,
+        prune_trials: bool = False,
+        prune_trials_margin: float = 0.02,
         converge: bool = False,
         num_threads: str | int | None = None,
         threads: str | int | None = None,
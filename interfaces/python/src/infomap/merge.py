@@ -160,11 +160,14 @@ def _select_winner(shards: Sequence[tuple[str, dict]]):
     """Return (shard_path, shard, winning_trial) with the global best codelength.
 
     Tie-break: lowest global trial index (so the result is independent of how
-    trials were partitioned across shards).
+    trials were partitioned across shards). Trials abandoned by --prune-trials
+    report the codelength they stopped at and have no tree, so they never win.
     """
     best = None  # (codelength, trial_index, shard_path, shard, trial)
     for path, shard in shards:
         for trial in shard["trials"]:
+            if trial.get("abandoned", False):
+                continue
             key = (float(trial["codelength"]), int(trial["trial"]))
             if best is None or key < best[0]:
                 best = (key, path, shard, trial)
@@ -226,30 +226,34 @@ INFOMAP_HOT double BiasedMapEquation::getDeltaCodelengthOnMovingNode(InfoNode& c
   return deltaL + deltaBiasedCost + deltaEntropyBiasCorrection;
 }
 
-INFOMAP_HOT double BiasedMapEquation::getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                                                            DeltaFlow& oldModuleDelta,
-                                                                            const OldSideTerms& oldSide,
-                                                                            DeltaFlow& newModuleDelta,
-                                                                            std::vector<FlowData>& moduleFlowData,
-                                                                            std::vector<unsigned int>& moduleMembers)
+INFOMAP_HOT void BiasedMapEquation::getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                                                        DeltaFlow& oldModuleDelta,
+                                                                        const OldSideTerms& oldSide,
+                                                                        const DeltaFlow* candidates,
+                                                                        unsigned int numCandidates,
+                                                                        std::vector<FlowData>& moduleFlowData,
+                                                                        std::vector<unsigned int>& moduleMembers,
+                                                                        DeltaBatchScratch& batch)
 {
-  double deltaL = Base::getDeltaCodelengthOnMovingNodeHoisted(current, oldModuleDelta, oldSide, newModuleDelta, moduleFlowData, moduleMembers);
+  Base::getDeltaCodelengthOnMovingNodeBatch(current, oldModuleDelta, oldSide, candidates, numCandidates, moduleFlowData, moduleMembers, batch);
 
   // See getDeltaCodelengthOnMovingNode: the two terms have independent switches.
   if (preferredNumModules == 0 && !useEntropyBiasCorrection)
-    return deltaL;
+    return;
 
-  int deltaNumModules = getDeltaNumModulesIfMoving(oldModuleDelta.module, newModuleDelta.module, moduleMembers);
+  for (unsigned int j = 0; j < numCandidates; ++j) {
+    int deltaNumModules = getDeltaNumModulesIfMoving(oldModuleDelta.module, candidates[j].module, moduleMembers);
 
-  const unsigned int numModules = numModulesAfterMove(deltaNumModules);
+    const unsigned int numModules = numModulesAfterMove(deltaNumModules);
 
-  double deltaBiasedCost = preferredNumModules == 0
-      ? 0.0
-      : calcNumModuleCost(numModules) - biasedCost;
+    double deltaBiasedCost = preferredNumModules == 0
+        ? 0.0
+        : calcNumModuleCost(numModules) - biasedCost;
 
-  double deltaEntropyBiasCorrection = calcEntropyBiasCorrection(numModules) - getEntropyBiasCorrection();
+    double deltaEntropyBiasCorrection = calcEntropyBiasCorrection(numModules) - getEntropyBiasCorrection();
 
-  return deltaL + deltaBiasedCost + deltaEntropyBiasCorrection;
+    batch.deltas[j] = batch.deltas[j] + deltaBiasedCost + deltaEntropyBiasCorrection;
+  }
 }
 
 // ===================================================
@@ -282,6 +286,30 @@ void BiasedMapEquation::updateCodelengthOnMovingNode(InfoNode& current,
   moduleEntropyBiasCorrection = calcModuleEntropyBiasCorrection();
 }
 
+void BiasedMapEquation::updateCodelengthOnChangedModules(const std::vector<unsigned int>& modules,
+                                                         const std::vector<FlowData>& flowBefore,
+                                                         const std::vector<unsigned int>& membersBefore,
+                                                         const std::vector<FlowData>& moduleFlowData,
+                                                         const std::vector<unsigned int>& moduleMembers)
+{
+  Base::updateCodelengthOnChangedModules(modules, flowBefore, moduleFlowData);
+
+  // Same guard as updateCodelengthOnMovingNode.
+  if (preferredNumModules == 0 && !useEntropyBiasCorrection)
+    return;
+
+  int deltaNumModules = 0;
+  for (std::size_t i = 0; i < modules.size(); ++i) {
+    deltaNumModules += (moduleMembers[modules[i]] > 0 ? 1 : 0) - (membersBefore[i] > 0 ? 1 : 0);
+  }
+
+  currentNumModules = numModulesAfterMove(deltaNumModules);
+  if (preferredNumModules != 0)
+    biasedCost = calcNumModuleCost(currentNumModules);
+  indexEntropyBiasCorrection = calcIndexEntropyBiasCorrection(currentNumModules);
+  moduleEntropyBiasCorrection = calcModuleEntropyBiasCorrection();
+}
+
 void BiasedMapEquation::consolidateModules(std::vector<InfoNode*>& modules)
 {
   unsigned int numModules = 0;
@@ -84,12 +84,14 @@ public:
 
   using Base::hoistOldSide;
 
-  double getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                               DeltaFlow& oldModuleDelta,
-                                               const OldSideTerms& oldSide,
-                                               DeltaFlow& newModuleDelta,
-                                               std::vector<FlowData>& moduleFlowData,
-                                               std::vector<unsigned int>& moduleMembers);
+  void getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                           DeltaFlow& oldModuleDelta,
+                                           const OldSideTerms& oldSide,
+                                           const DeltaFlow* candidates,
+                                           unsigned int numCandidates,
+                                           std::vector<FlowData>& moduleFlowData,
+                                           std::vector<unsigned int>& moduleMembers,
+                                           DeltaBatchScratch& batch);
 
   // ===================================================
   // Consolidation
@@ -101,6 +103,12 @@ public:
                                     std::vector<FlowData>& moduleFlowData,
                                     std::vector<unsigned int>& moduleMembers);
 
+  void updateCodelengthOnChangedModules(const std::vector<unsigned int>& modules,
+                                        const std::vector<FlowData>& flowBefore,
+                                        const std::vector<unsigned int>& membersBefore,
+                                        const std::vector<FlowData>& moduleFlowData,
+                                        const std::vector<unsigned int>& moduleMembers);
+
   void consolidateModules(std::vector<InfoNode*>& modules);
 
   // ===================================================
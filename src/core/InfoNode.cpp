@@ -101,7 +101,7 @@ InfoNode const* InfoNode::getInfomapRoot() const noexcept
 bool InfoNode::disposeInfomap() noexcept
 {
   if (m_infomap != nullptr) {
-    delete m_infomap;
+    InfomapBase::releaseSubInfomap(m_infomap);
     m_infomap = nullptr;
     return true;
   }
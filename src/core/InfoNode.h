@@ -288,8 +288,9 @@ public:
   InfoNode const* getInfomapRoot() const noexcept;
 
   /**
-   * Dispose the Infomap instance if it exists
-   * @return true if an existing Infomap instance was deleted
+   * Dispose the Infomap instance if it exists. The instance goes back to the
+   * calling thread's sub-Infomap pool (see InfomapBase::releaseSubInfomap).
+   * @return true if an existing Infomap instance was disposed
    */
   bool disposeInfomap() noexcept;
 
@@ -489,6 +490,13 @@ public:
    */
   void deleteChildren() noexcept;
 
+  // Size the edge lists up front when the number of edges to add is known
+  void reserveEdges(std::size_t numOutEdges, std::size_t numInEdges)
+  {
+    m_outEdges.reserve(numOutEdges);
+    m_inEdges.reserve(numInEdges);
+  }
+
   void addOutEdge(InfoNode& target, double weight, double flow = 0.0) noexcept
   {
     auto* edge = m_edgePool != nullptr
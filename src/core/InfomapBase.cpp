@@ -41,6 +41,7 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include <array>
 #include <iomanip>
 #include <limits>
 #include <map>
@@ -180,6 +181,27 @@ namespace {
     int m_previous;
   };
 
+  // Lets a parallel-trial worker open teams of its own from inside the worker
+  // team (detail::canOpenTeam), and gives the pooled thread back its previous
+  // level on the way out.
+  class ScopedOwnTeamLevel {
+  public:
+    explicit ScopedOwnTeamLevel(bool ownsTeams)
+        : m_previous(detail::t_ownTeamLevel)
+    {
+      if (ownsTeams)
+        detail::t_ownTeamLevel = omp_get_active_level();
+    }
+
+    ~ScopedOwnTeamLevel()
+    {
+      detail::t_ownTeamLevel = m_previous;
+    }
+
+  private:
+    int m_previous;
+  };
+
   // Clamp before the signed cast: the budget is unsigned, and a value above
   // INT_MAX would make omp_set_num_threads see a negative thread count.
   int asOpenMpThreadCount(unsigned int threads)
@@ -211,6 +233,72 @@ namespace {
     unsigned long m_previous;
   };
 
+  // The objective InfomapBase::initOptimizer builds for a config.
+  enum OptimizerKind : unsigned int {
+    BiasedOptimizer,
+    MemOptimizer,
+    MetaOptimizer,
+    RegularizedMultilayerOptimizer,
+    LossyOptimizer,
+  };
+
+  unsigned int optimizerKind(const Config& config, bool forceNoMemory)
+  {
+    if (config.haveMetaData())
+      return MetaOptimizer;
+    if (config.haveMemory() && !forceNoMemory) {
+#if INFOMAP_FEATURE_REGULARIZED_MULTILAYER
+      if (config.isRegularizedMultilayerFlow())
+        return RegularizedMultilayerOptimizer;
+#endif
+      return MemOptimizer;
+    }
+#if INFOMAP_FEATURE_LOSSY_MAP_EQUATION
+    if (config.lossy)
+      return LossyOptimizer;
+#endif
+    return BiasedOptimizer;
+  }
+
+  // Finished sub-Infomap instances kept by one thread for the next sub-run.
+  // Recursive partitioning creates one sub-Infomap per refined module, most of
+  // them small, and only the few of one nesting chain are alive on a thread at
+  // a time, so a short pool serves nearly all of them. Instances whose node or
+  // edge pool grew past the caps are deleted instead of kept, which bounds the
+  // memory a thread holds on to after the run.
+  class SubInfomapPool {
+  public:
+    static constexpr std::size_t maxInstances = 4;
+    static constexpr std::size_t maxNodeCapacity = 4096;
+    static constexpr std::size_t maxEdgeCapacity = 16384;
+
+    SubInfomapPool() = default;
+    SubInfomapPool(const SubInfomapPool&) = delete;
+    SubInfomapPool& operator=(const SubInfomapPool&) = delete;
+
+    ~SubInfomapPool()
+    {
+      for (std::size_t i = 0; i < m_size; ++i)
+        delete m_instances[i];
+    }
+
+    InfomapBase* pop() noexcept { return m_size == 0 ? nullptr : m_instances[--m_size]; }
+
+    bool push(InfomapBase* infomap) noexcept
+    {
+      if (m_size == maxInstances)
+        return false;
+      m_instances[m_size++] = infomap;
+      return true;
+    }
+
+  private:
+    std::array<InfomapBase*, maxInstances> m_instances {};
+    std::size_t m_size = 0;
+  };
+
+  thread_local SubInfomapPool t_subInfomapPool;
+
 } // namespace
 
 class InfomapBase::RunSession {
@@ -265,7 +353,9 @@ public:
     m_reportNetwork.links = m_network.numLinks();
     m_reportNetwork.directed = !m_infomap.isUndirectedFlow();
     m_runParallelTrials = selectParallelTrialMode();
-    m_threadsUsed = m_runParallelTrials ? parallelTrialWorkers() : 1;
+    if (m_infomap.pruneTrials && !m_runParallelTrials)
+      Console::warn(0, "--prune-trials only applies to --parallel-trials; running every trial to completion.");
+    m_threadsUsed = m_runParallelTrials ? parallelTrialWorkers() * trialWorkerThreads() : 1;
     releaseInputLinksIfCli();
     logRunPartitionStart();
     Result result;
@@ -295,6 +385,9 @@ public:
       const unsigned int patience = Config::convergePatience;
       Console::detail(0, "auto: stopped after {} trials (no improvement in last {})", m_trialsRun, patience);
     }
+    if (m_numAbandonedTrials > 0) {
+      Console::detail(0, "pruned: abandoned {} of {} trials behind the best by more than {}%", m_numAbandonedTrials, m_trialsRun, io::toPrecision(m_infomap.pruneTrialsMargin * 100, 2, true));
+    }
     std::string codelengthRange;
     std::string topModulesRange;
     if (m_trialsRun > 1) {
@@ -411,6 +504,18 @@ private:
     result.bestTree = NodePaths(m_infomap.numLeafNodes());
     result.bestTreeNeedsRestore = true;
     const unsigned int numWorkers = parallelTrialWorkers();
+    // With threads to spare beyond one per worker, each worker runs its trials
+    // on a nested team of its share, and the workers still busy take over the
+    // threads of those that have run out of trials (see TrialThreadShare).
+    const bool nestedTeams = trialWorkerThreads() > 1;
+    detail::TrialThreadShare threadShare;
+#ifdef _OPENMP
+    threadShare.totalThreads = static_cast<unsigned int>(std::max(1, omp_get_max_threads()));
+#endif
+    threadShare.activeWorkers.store(numWorkers);
+    // Trials go to the workers in order as they free up, so a worker with a
+    // quick trial behind it takes the next one instead of idling.
+    std::atomic<unsigned int> nextTrial(0);
 
     std::vector<double> codelengths(m_numTrials, std::numeric_limits<double>::max());
     std::vector<unsigned int> numTopModules(m_numTrials, 0);
@@ -420,16 +525,27 @@ private:
     std::mutex bestResultMutex;
     std::mutex errorMutex;
     std::mutex outputMutex;
+    // The best finished trial's codelength and the best two-level codelength
+    // after partition(), read by the --prune-trials checkpoints.
+    std::atomic<double> bestTrialCodelength(std::numeric_limits<double>::max());
+    std::atomic<double> bestTwoLevelTrialCodelength(std::numeric_limits<double>::max());
+    std::atomic<unsigned int> numAbandoned(0);
 
 #ifdef _OPENMP
-    ScopedOpenMpMaxActiveLevels scopedMaxActiveLevels(1);
+    ScopedOpenMpMaxActiveLevels scopedMaxActiveLevels(nestedTeams ? 2 : 1);
 #pragma omp parallel for schedule(dynamic) num_threads(numWorkers)
 #endif
     for (int workerIndex = 0; workerIndex < static_cast<int>(numWorkers); ++workerIndex) {
+#ifdef _OPENMP
+      const ScopedOwnTeamLevel scopedOwnTeamLevel(nestedTeams);
+#endif
       auto workerConfig = m_infomap.getConfig();
       workerConfig.numTrials = 1;
       workerConfig.parallelTrials = false;
-      workerConfig.innerParallelization = false;
+      // Workers with a nested team run the parallel sweep on it. A deterministic
+      // run keeps the sweep in its workers either way: without a nested team it
+      // runs on one thread, but takes the same moves as with any thread count.
+      workerConfig.innerParallelization = m_infomap.innerParallelization && (m_infomap.deterministic || nestedTeams);
       workerConfig.seedToRandomNumberGenerator = m_baseSeed + static_cast<unsigned int>(workerIndex);
 
       InfomapBase worker(workerConfig);
@@ -437,23 +553,39 @@ private:
       // Share the cancel flag so workers observe a cancel; they only read it and
       // unwind, caught by the per-trial handler below (issue #412).
       worker.inheritRuntimeContext(m_infomap);
+      if (m_infomap.pruneTrials) {
+        worker.m_bestTrialCodelength = &bestTrialCodelength;
+        worker.m_bestTwoLevelTrialCodelength = &bestTwoLevelTrialCodelength;
+      }
+      if (nestedTeams) {
+        worker.m_trialThreadShare = &threadShare;
+        worker.adoptTrialThreadShare();
+      }
+      // Like the serial loop, build the worker's leaf network once and only
+      // flatten the previous trial's modules away before the next one.
+      bool haveLeafNetwork = false;
 
-      for (unsigned int trialIndex = static_cast<unsigned int>(workerIndex); trialIndex < m_numTrials; trialIndex += numWorkers) {
+      for (unsigned int trialIndex = nextTrial.fetch_add(1); trialIndex < m_numTrials; trialIndex = nextTrial.fetch_add(1)) {
+        const auto seed = trialSeed(trialIndex);
+        int threadNumber = 0;
+#ifdef _OPENMP
+        threadNumber = omp_get_thread_num();
+#endif
+        Stopwatch trialTimer(true);
         try {
           Log::ScopedMute muteWorkerLogs;
-          const auto seed = trialSeed(trialIndex);
           worker.seedToRandomNumberGenerator = seed;
           worker.reseed(static_cast<unsigned int>(seed));
-          int threadNumber = 0;
-#ifdef _OPENMP
-          threadNumber = omp_get_thread_num();
-#endif
-          Stopwatch trialTimer(true);
 
           NodePaths trialTree;
           unsigned int trialNumLevels = 0;
           std::ostringstream trialStatistics;
-          worker.initNetwork(m_network);
+          if (haveLeafNetwork) {
+            worker.removeModules();
+          } else {
+            worker.initNetwork(m_network);
+            haveLeafNetwork = true;
+          }
           initTrialPartition(worker);
           executeTrial(worker);
           worker.root().sortChildrenOnFlow();
@@ -494,8 +626,21 @@ private:
             result.bestHierarchicalCodelength = trialCodelength;
             result.bestTrialIndex = trialIndex;
             result.bestTree = std::move(trialTree);
+            bestTrialCodelength.store(trialCodelength, std::memory_order_relaxed);
           }
+        } catch (const TrialAbandoned& abandoned) {
+          // Record where the trial stopped; it cannot be the best, so its tree
+          // is dropped. Expand a hard partition so the next trial reuses the
+          // leaf network as usual.
+          if (worker.haveHardPartition())
+            worker.restoreHardPartition();
+          codelengths[trialIndex] = abandoned.codelength;
+          numTopModules[trialIndex] = worker.numTopModules();
+          m_timing.recordTrial(trialIndex, threadNumber, seed, trialTimer.getElapsedTimeInSec(), abandoned.codelength, worker.numTopModules(), worker.numLevels(), true);
+          numAbandoned.fetch_add(1, std::memory_order_relaxed);
         } catch (const std::exception& e) {
+          // A trial that threw may have left a hard partition swapped in.
+          haveLeafNetwork = false;
           std::lock_guard<std::mutex> lock(errorMutex);
           if (!hasError || trialIndex < firstErrorTrial) {
             hasError = true;
@@ -503,6 +648,7 @@ private:
             firstError = e.what();
           }
         } catch (...) {
+          haveLeafNetwork = false;
           std::lock_guard<std::mutex> lock(errorMutex);
           if (!hasError || trialIndex < firstErrorTrial) {
             hasError = true;
@@ -511,6 +657,7 @@ private:
           }
         }
       }
+      threadShare.activeWorkers.fetch_sub(1, std::memory_order_relaxed);
     }
 
     // Surface a cancel as InterruptionError, not the generic "Parallel trial
@@ -525,6 +672,7 @@ private:
 
     m_infomap.m_codelengths = std::move(codelengths);
     m_infomap.m_numTopModules = std::move(numTopModules);
+    m_numAbandonedTrials = numAbandoned.load();
     return result;
   }
 
@@ -542,6 +690,18 @@ private:
 #endif
   }
 
+  // The threads each parallel-trial worker starts with: the budget split evenly
+  // over the workers. Above one, the workers run their trials on nested teams.
+  unsigned int trialWorkerThreads() const
+  {
+#ifdef _OPENMP
+    const unsigned int maxOpenMpThreads = static_cast<unsigned int>(std::max(1, omp_get_max_threads()));
+    return std::max(1u, maxOpenMpThreads / parallelTrialWorkers());
+#else
+    return 1;
+#endif
+  }
+
   void restoreBestResult(const Result& result)
   {
     // Compare against the actual executed trial count (m_trialsRun), not the cap
@@ -581,14 +741,21 @@ private:
     Console::warn(0, "--parallel-trials requires an OpenMP build; running trials serially.");
     return false;
 #else
-    if (m_infomap.innerParallelization) {
-      Console::warn(0, "--parallel-trials ignores --inner-parallelization inside trial workers.");
-    }
     const unsigned int workers = parallelTrialWorkers();
+    const unsigned int workerThreads = trialWorkerThreads();
+    const bool nestedTeams = workerThreads > 1;
+    if (m_infomap.innerParallelization && !nestedTeams && !m_infomap.deterministic) {
+      Console::warn(0, "--parallel-trials ignores --inner-parallelization inside trial workers without threads to spare for each.");
+    }
+    const char* innerState = !m_infomap.innerParallelization ? "off"
+        : nestedTeams                                        ? "on"
+                                                             : "single-threaded, deterministic";
+    const std::string workerSummary = nestedTeams ? fmt::format(FMT_STRING("{} workers × {} threads"), workers, workerThreads) : fmt::format(FMT_STRING("{} workers"), workers);
     Console console;
     Log() << "\n"
-          << console.dim() << "  Parallel trials: " << workers << " workers from "
-          << omp_get_max_threads() << " OpenMP threads (memory scales with workers; inner parallelization off)"
+          << console.dim() << "  Parallel trials: " << workerSummary << " from "
+          << omp_get_max_threads() << " OpenMP threads (memory scales with workers; inner parallelization "
+          << innerState << ")"
           << console.reset() << "\n";
     return true;
 #endif
@@ -853,10 +1020,13 @@ private:
         Console::warn(0, "Thread budget {} ({}) exceeds the available cpuset of {} CPUs; this may oversubscribe the node.", m_threadBudget.threads, source, m_cpusetCount);
       }
       if (m_cpusetCount > 0) {
-        const unsigned int innerThreads = (m_infomap.innerParallelization && !m_runParallelTrials) ? m_threadBudget.threads : 1;
-        const unsigned int demand = m_threadsUsed * innerThreads;
+        const unsigned int workers = m_runParallelTrials ? parallelTrialWorkers() : 1;
+        unsigned int innerThreads = m_infomap.innerParallelization ? m_threadBudget.threads : 1;
+        if (m_runParallelTrials)
+          innerThreads = trialWorkerThreads();
+        const unsigned int demand = workers * innerThreads;
         if (demand > m_cpusetCount) {
-          Console::warn(0, "{} trial workers × {} inner threads = {} exceeds the available cpuset of {} CPUs.", m_threadsUsed, innerThreads, demand, m_cpusetCount);
+          Console::warn(0, "{} trial workers × {} inner threads = {} exceeds the available cpuset of {} CPUs.", workers, innerThreads, demand, m_cpusetCount);
         }
       }
     }
@@ -976,6 +1146,11 @@ private:
 
   void executeTrial(InfomapBase& infomap)
   {
+    // A trial is a function of its seed alone, not of the trials this instance
+    // ran before it: parallel-trial workers take trials in whatever order they
+    // free up, and the serial loop runs all of them on the main instance.
+    if (infomap.m_optimizer)
+      infomap.m_optimizer->restartSweeps();
     if (!infomap.noInfomap)
       infomap.runPartition();
     else
@@ -1052,6 +1227,8 @@ public:
       report.flowConverged = m_infomap.m_network.flowConverged();
       report.flowIterations = m_infomap.m_network.flowIterations();
       report.flowError = m_infomap.m_network.flowError();
+      report.flowCacheFile = m_infomap.m_network.flowCacheFile();
+      report.flowCacheHit = m_infomap.m_network.flowCacheHit();
       report.trialCodelengths = m_infomap.m_codelengths;
       report.trialTopModules = m_infomap.m_numTopModules;
       writeJsonReport(m_infomap.summaryJsonPath, runSummaryReportJson(report), m_infomap.overwriteOutput());
@@ -1073,6 +1250,10 @@ public:
       report.network = m_reportNetwork;
       report.timing = m_timing.phases();
       report.trials = m_timing.trials();
+      report.subInfomaps = m_infomap.m_subInfomapStats->instances.load(std::memory_order_relaxed);
+      report.subInfomapsReused = m_infomap.m_subInfomapStats->reused.load(std::memory_order_relaxed);
+      report.partitionTasksCreated = m_infomap.m_partitionTaskStats->created.load(std::memory_order_relaxed);
+      report.partitionTasksExecuted = m_infomap.m_partitionTaskStats->executed.load(std::memory_order_relaxed);
       report.includeMemory = m_infomap.memoryReport;
       if (report.includeMemory) {
         report.memory = currentMemoryReport(report.network.nodes, report.network.links);
@@ -1106,6 +1287,7 @@ public:
         entry.numLevels = rec.numLevels;
         entry.thread = rec.thread;
         entry.timeSec = rec.timeSec;
+        entry.abandoned = rec.abandoned;
         trialResultsFile.trials.push_back(entry);
       }
 
@@ -1181,6 +1363,7 @@ private:
   const bool m_convergeTrials = m_infomap.convergeTrials;
   unsigned int m_trialsRun = m_infomap.numTrials; // actual count; equals m_numTrials unless --converge stops early
   bool m_autoStopped = false;
+  unsigned int m_numAbandonedTrials = 0; // --prune-trials
   bool m_runParallelTrials = false;
   unsigned int m_threadsUsed = 1;
   ThreadBudget m_threadBudget;
@@ -1287,6 +1470,10 @@ void InfomapBase::run(const std::string& parameters)
     initMetaData(metaDataFile);
   }
 
+  if (!initialFlowFile.empty()) {
+    m_network.readInitialFlow(initialFlowFile);
+  }
+
   run(m_network);
 
   printPrettyEnd(m_endDate, m_elapsedTime);
@@ -1301,6 +1488,10 @@ void InfomapBase::run(Network& network)
   // the instance is reusable after an interrupted run (issue #412).
   m_ownerThreadId = std::this_thread::get_id();
   m_cancelRequested.store(false, std::memory_order_relaxed);
+  m_subInfomapStatsStorage.instances.store(0, std::memory_order_relaxed);
+  m_subInfomapStatsStorage.reused.store(0, std::memory_order_relaxed);
+  m_partitionTaskStatsStorage.created.store(0, std::memory_order_relaxed);
+  m_partitionTaskStatsStorage.executed.store(0, std::memory_order_relaxed);
   pollInterrupt();
 
   TimingRegistry timing;
@@ -2002,31 +2193,53 @@ void InfomapBase::generateSubNetwork(InfoNode& parent)
 
   unsigned int numNodes = parent.childDegree();
   m_leafNodes.resize(numNodes);
+  std::vector<InfoNode*> children;
+  children.reserve(numNodes);
+  for (InfoNode& node : parent)
+    children.push_back(&node);
+
+  // Count the links of each node within the parent, so the pools and the
+  // cloned edge lists get their exact sizes. A super network over many
+  // modules splits the counting across a team; the counts are the same.
+  const bool parallel = detail::useParallelModuleAggregation(numNodes);
+  const auto numNodesInt = static_cast<int>(numNodes);
+  (void)parallel;
+  std::vector<unsigned int> numInternalOutEdges(numNodes, 0);
+  std::vector<unsigned int> numInternalInEdges(numNodes, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (parallel)
+#endif
+  for (int i = 0; i < numNodesInt; ++i) {
+    InfoNode& node = *children[i];
+    for (InfoEdge* e : node.outEdges()) {
+      if (e->target->parent == &parent)
+        ++numInternalOutEdges[i];
+    }
+    for (InfoEdge* e : node.inEdges()) {
+      if (e->source->parent == &parent)
+        ++numInternalInEdges[i];
+    }
+  }
+  const std::size_t numInternalEdges = std::accumulate(numInternalOutEdges.begin(), numInternalOutEdges.end(), std::size_t { 0 });
+
   // Reserve both pools to the exact clone counts. The per-pool ramp slack is
   // small, but the recursive phase keeps many sub-Infomaps alive at once and
   // the summed slack dominates the pool RSS overhead on higher-order networks;
   // exact first chunks remove it. Module nodes allocated later still ramp from
   // kInitialChunk, which stays tight for the tiny refined modules.
   m_nodePool.reserve(numNodes);
-  unsigned int numInternalEdges = 0;
-  for (InfoNode& node : parent) {
-    for (InfoEdge* e : node.outEdges()) {
-      if (e->target->parent == &parent)
-        ++numInternalEdges;
-    }
-  }
   m_edgePool.reserve(numInternalEdges);
 
   Console::detail(1, "generate sub network with {} nodes", numNodes);
 
-  unsigned int childIndex = 0;
-  for (InfoNode& node : parent) {
+  for (unsigned int childIndex = 0; childIndex < numNodes; ++childIndex) {
+    InfoNode& node = *children[childIndex];
     auto* clonedNode = &allocNode(node);
     clonedNode->initClean();
+    clonedNode->reserveEdges(numInternalOutEdges[childIndex], numInternalInEdges[childIndex]);
     m_root.addChild(clonedNode);
     node.index = childIndex; // Set index to its place in this subnetwork to be able to find edge target below
     m_leafNodes[childIndex] = clonedNode;
-    ++childIndex;
   }
 
   InfoNode* parentPtr = &parent;
@@ -2079,6 +2292,14 @@ std::vector<unsigned int> InfomapBase::noiseTopModules() const
 // Run: *
 // ===================================================
 
+void InfomapBase::adoptTrialThreadShare() const
+{
+#ifdef _OPENMP
+  if (m_trialThreadShare != nullptr)
+    omp_set_num_threads(static_cast<int>(m_trialThreadShare->threadsPerWorker()));
+#endif
+}
+
 void InfomapBase::hierarchicalPartition()
 {
   Console::detail(1, "hierarchical partition");
@@ -2169,11 +2390,13 @@ void InfomapBase::hierarchicalPartition()
       Console::detail(1, "fine-tune bottom modules: improvement {:g}% {} codelength {}", (diffCodelength / codelengthBefore) * 100, Console::arrow(), io::toPrecision(codelengthAfter));
     }
 
+    adoptTrialThreadShare();
     recursivePartition();
     return;
   }
 
   partition();
+  abandonTrialIfBehindTwoLevel(m_hierarchicalCodelength);
 
   if (numTopModules() == 1 || numTopModules() == numLeafNodes()) {
     Console::detail(1, "trivial partition, skipping hierarchical search");
@@ -2181,7 +2404,9 @@ void InfomapBase::hierarchicalPartition()
   }
 
   if (numTopModules() > preferredNumberOfModules) {
+    adoptTrialThreadShare();
     findHierarchicalSuperModules();
+    abandonTrialIfBehindHierarchical(m_hierarchicalCodelength);
   }
 
   if (onlySuperModules) {
@@ -2200,6 +2425,7 @@ void InfomapBase::hierarchicalPartition()
     m_hierarchicalCodelength = calcCodelengthOnTree(root(), true);
   }
 
+  adoptTrialThreadShare();
   recursivePartition();
 }
 
@@ -2213,6 +2439,8 @@ void InfomapBase::partition()
   double oldCodelength = initialCodelength;
 
   m_tuneIterationIndex = 0;
+  m_fineTunedModules.clear();
+  adoptTrialThreadShare();
   findTopModulesRepeatedly(levelAggregationLimit);
 
   double newCodelength = getCodelength();
@@ -2225,6 +2453,7 @@ void InfomapBase::partition()
   bool coarseTuned = false;
   while (numTopModules() > 1 && (m_tuneIterationIndex + 1) != tuneIterationLimit) {
     ++m_tuneIterationIndex;
+    adoptTrialThreadShare();
     if (doFineTune) {
       Log(3) << "\n";
       unsigned int numEffectiveLoops = fineTune();
@@ -2324,8 +2553,10 @@ void InfomapBase::restoreHardPartition()
     node->replaceWithChildren();
   }
 
-  // Swap back original leaf nodes
+  // Swap back original leaf nodes. The hard modules were replaced by their
+  // children above, so drop them rather than leave haveHardPartition() set.
   m_originalLeafNodes.swap(m_leafNodes);
+  m_originalLeafNodes.clear();
 
   Console::detail(1, "expanded {} hard modules to {} original nodes", numExpandedNodes, numExpandedChildren);
 }
@@ -2565,6 +2796,11 @@ void InfomapBase::findTopModulesRepeatedly(unsigned int maxLevels)
   Console::detail(1, 2, "iter {}: codelength {} {} {}, {} modules ({} non-trivial); passes ({}*loops): {}", m_tuneIterationIndex + 1, initialCodelength, Console::arrow(), io::stringify(*this), numTopModules(), m_numNonTrivialTopModules, m_isCoarseTune ? "modules" : "nodes", io::stringify(passList, ", "));
 }
 
+// Modules with fewer children than this are partitioned inline by the
+// coarse-tune loop instead of as their own task, keeping the task count
+// proportional to the work that can actually run in parallel.
+constexpr unsigned int minChildDegreeForPartitionTask = 16;
+
 unsigned int InfomapBase::fineTune()
 {
   if (numLevels() != 2)
@@ -2588,8 +2824,20 @@ unsigned int InfomapBase::fineTune()
 
   Log(3).print(" -> moved to codelength {} in {} existing modules. Try tuning...\n", io::stringify(*this), numActiveModules());
 
+  if (parallelFineTune)
+    markLeafNodesNearChangedModulesDirty(modules, numTopModules());
+
   // Continue to optimize from there to tune leaf nodes
+  m_isParallelFineTune = parallelFineTune;
   unsigned int numEffectiveLoops = optimizeActiveNetwork();
+  m_isParallelFineTune = false;
+
+  if (parallelFineTune) {
+    m_fineTunedModules.resize(numLeafNodes());
+    for (unsigned int i = 0; i < numLeafNodes(); ++i)
+      m_fineTunedModules[i] = numEffectiveLoops == 0 ? modules[i] : m_leafNodes[i]->index;
+  }
+
   if (numEffectiveLoops == 0) {
     restoreConsolidatedOptimizationPointIfNoImprovement();
     Log(4) << "Fine-tune didn't improve solution, restoring last.\n";
@@ -2603,6 +2851,56 @@ unsigned int InfomapBase::fineTune()
   return numEffectiveLoops;
 }
 
+/**
+ * Leave dirty only the leaf nodes in or linked to a module whose members
+ * changed since the previous fine-tune ended, for the active-set sweep.
+ *
+ * A module is unchanged when all its leaves ended the previous fine-tune in
+ * one module of the same size. Every node of the first fine-tune stays dirty.
+ */
+void InfomapBase::markLeafNodesNearChangedModulesDirty(const std::vector<unsigned int>& modules, unsigned int numModules)
+{
+  const auto numNodes = static_cast<unsigned int>(modules.size());
+  if (m_fineTunedModules.size() != numNodes)
+    return;
+
+  constexpr auto noModule = std::numeric_limits<unsigned int>::max();
+  std::vector<unsigned int> previousModule(numModules, noModule);
+  std::vector<unsigned int> moduleSize(numModules, 0);
+  std::vector<unsigned int> previousModuleSize(numNodes, 0);
+  std::vector<char> changed(numModules, 0);
+  for (unsigned int i = 0; i < numNodes; ++i) {
+    const unsigned int module = modules[i];
+    const unsigned int previous = m_fineTunedModules[i];
+    ++moduleSize[module];
+    ++previousModuleSize[previous];
+    if (previousModule[module] == noModule)
+      previousModule[module] = previous;
+    else if (previousModule[module] != previous)
+      changed[module] = 1;
+  }
+  unsigned int numChanged = 0;
+  for (unsigned int module = 0; module < numModules; ++module) {
+    if (!changed[module] && moduleSize[module] != 0 && moduleSize[module] != previousModuleSize[previousModule[module]])
+      changed[module] = 1;
+    numChanged += changed[module];
+  }
+
+  // The leaves' index is their module here, set by moveActiveNodesToPredefinedModules.
+  unsigned int numDirty = 0;
+  for (auto* node : m_leafNodes) {
+    bool dirty = changed[node->index] != 0;
+    for (auto it = node->outEdges().begin(); !dirty && it != node->outEdges().end(); ++it)
+      dirty = changed[(*it)->target->index] != 0;
+    for (auto it = node->inEdges().begin(); !dirty && it != node->inEdges().end(); ++it)
+      dirty = changed[(*it)->source->index] != 0;
+    node->dirty = dirty;
+    numDirty += dirty;
+  }
+
+  Log(4).print("Fine-tune {} nodes near {}/{} changed modules.\n", numDirty, numChanged, numModules);
+}
+
 unsigned int InfomapBase::coarseTune()
 {
   if (numLevels() != 2)
@@ -2612,39 +2910,111 @@ unsigned int InfomapBase::coarseTune()
 
   Log::ScopedMute muteNestedMainRun(isMainInfomap());
 
-  unsigned int moduleIndexOffset = 0;
-  for (auto& node : m_root) {
+  // Partition every module on its own, as one task per module. Each
+  // sub-Infomap re-seeds from the config seed, so its result does not depend on
+  // the order the tasks run in. The tasks only write their own module's leaf
+  // indices, relative to the module, and its number of sub-modules; the offsets
+  // into the common index range follow afterwards as a prefix sum in module
+  // order, which gives the same indices as partitioning the modules one by one.
+  // Not while the sub-runs' own move sweeps are spread over the threads without
+  // --deterministic: one-thread sweeps inside the tasks would take other moves.
+  std::vector<InfoNode*> topModules;
+  topModules.reserve(numTopModules());
+  for (auto& node : m_root)
+    topModules.push_back(&node);
+  std::vector<unsigned int> numSubModules(topModules.size(), 1);
+
+  const bool parallelSubRuns = !innerParallelization || deterministic;
+  const bool muteSubRuns = Log::isThreadMuted();
+  std::exception_ptr subRunError;
+
+  const auto partitionModule = [&](std::size_t moduleIndex) {
+    InfoNode& node = *topModules[moduleIndex];
     // Don't search for sub-modules in too small modules
     if (node.childDegree() < 2) {
-      for (auto& child : node) {
-        child.index = moduleIndexOffset;
-      }
-      moduleIndexOffset += 1;
-      continue;
-    } else {
-      InfomapBase& subInfomap = getSubInfomap(node)
-                                    .setTwoLevel(true)
-                                    .setTuneIterationLimit(1);
-      // Free the sub-Infomap on interrupt before unwinding (issue #412).
-      try {
-        subInfomap.initNetwork(node).run();
-      } catch (const InterruptionError&) {
-        node.disposeInfomap();
-        throw;
-      }
+      for (auto& child : node)
+        child.index = 0;
+      return;
+    }
+    Log::ScopedMute muteSubRun(muteSubRuns);
+    InfomapBase& subInfomap = getSubInfomap(node)
+                                  .setTwoLevel(true)
+                                  .setTuneIterationLimit(1);
+    // Contain any error from the sub-run so it can't escape an OpenMP task;
+    // free the sub-Infomap and rethrow after the tasks have joined (#412).
+    try {
+      subInfomap.initNetwork(node).run();
+    } catch (...) {
+      node.disposeInfomap();
+#ifdef _OPENMP
+#pragma omp critical(coarseTuneError)
+#endif
+      if (!subRunError)
+        subRunError = std::current_exception();
+      return;
+    }
 
-      auto originalLeafIt = node.begin_child();
-      for (auto& subLeafPtr : subInfomap.leafNodes()) {
-        InfoNode& subLeaf = *subLeafPtr;
-        originalLeafIt->index = subLeaf.index + moduleIndexOffset;
-        ++originalLeafIt;
-      }
-      moduleIndexOffset += subInfomap.numTopModules();
+    auto originalLeafIt = node.begin_child();
+    for (auto& subLeafPtr : subInfomap.leafNodes()) {
+      originalLeafIt->index = subLeafPtr->index;
+      ++originalLeafIt;
+    }
+    numSubModules[moduleIndex] = subInfomap.numTopModules();
 
-      node.disposeInfomap();
+    node.disposeInfomap();
+  };
+
+  if (parallelSubRuns) {
+    // Spawn the largest modules first so the dominant sub-runs start immediately
+    std::vector<std::size_t> spawnOrder(topModules.size());
+    std::iota(spawnOrder.begin(), spawnOrder.end(), std::size_t { 0 });
+    std::sort(spawnOrder.begin(), spawnOrder.end(), [&topModules](std::size_t a, std::size_t b) {
+      return topModules[a]->data.flow > topModules[b]->data.flow;
+    });
+
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+    {
+      for (auto moduleIndex : spawnOrder) {
+        // Stop spawning once cancelled; never throw inside the task region (#412).
+        if (interruptRequested())
+          break;
+        // NOLINTNEXTLINE(bugprone-branch-clone) -- the branches differ by the task pragma
+        if (topModules[moduleIndex]->childDegree() < minChildDegreeForPartitionTask) {
+          partitionModule(moduleIndex);
+        } else {
+#ifdef _OPENMP
+#pragma omp task firstprivate(moduleIndex)
+#endif
+          partitionModule(moduleIndex);
+        }
+      }
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+    }
+  } else {
+    for (std::size_t moduleIndex = 0; moduleIndex < topModules.size(); ++moduleIndex) {
+      partitionModule(moduleIndex);
+      if (subRunError)
+        break;
     }
   }
 
+  if (subRunError)
+    std::rethrow_exception(subRunError);
+  // Tasks have joined: throwing here is safe (outside any OpenMP block).
+  checkCancelled();
+
+  unsigned int moduleIndexOffset = 0;
+  for (std::size_t moduleIndex = 0; moduleIndex < topModules.size(); ++moduleIndex) {
+    for (auto& child : *topModules[moduleIndex])
+      child.index += moduleIndexOffset;
+    moduleIndexOffset += numSubModules[moduleIndex];
+  }
+
   Log(4).print("Move leaf nodes to {} sub-modules... \n", moduleIndexOffset);
   // Put leaf modules in the calculated sub-modules
   std::vector<unsigned int> subModules(numLeafNodes());
@@ -2840,7 +3210,9 @@ unsigned int InfomapBase::findHierarchicalSuperModulesFast(unsigned int superLev
 
     initPartition();
 
+    m_isParallelSuperLevel = parallelSuperModules && haveModules();
     unsigned int numEffectiveLoops = optimizeActiveNetwork();
+    m_isParallelSuperLevel = false;
 
     double codelength = getCodelength();
     double indexCodelength = getIndexCodelength();
@@ -2973,11 +3345,6 @@ unsigned int InfomapBase::removeSubModules(bool recalculateCodelengthOnTree)
   return numLevelsDeleted;
 }
 
-// Sub-modules with fewer children than this are partitioned inline by the
-// task that found them instead of as their own task, keeping the task count
-// proportional to the work that can actually run in parallel.
-constexpr unsigned int minChildDegreeForPartitionTask = 16;
-
 namespace detail {
   // Per-module result of the recursive partitioning task graph. Children are
   // sized once before their tasks are spawned, so each task writes only its
@@ -3023,9 +3390,10 @@ unsigned int InfomapBase::recursivePartition()
     isSilent = Log::isSilent();
   }
 
-  // Run the whole recursion as a task graph: every module is one task that
-  // spawns tasks for its accepted sub-modules, so threads flow from finished
-  // branches into deeper levels instead of waiting at per-level barriers.
+  // Run the whole recursion as a task graph: every module is partitioned in a
+  // task (small modules share one, see spawnPartitionTasks) that spawns tasks
+  // for its accepted sub-modules, so threads flow from finished branches into
+  // deeper levels instead of waiting at per-level barriers.
   // Each sub-Infomap re-seeds from the config seed, so per-module results are
   // independent of execution order. Per-module statistics are recorded and
   // aggregated afterwards in the same order as the former level-synchronous
@@ -3035,31 +3403,21 @@ unsigned int InfomapBase::recursivePartition()
 
   if (shouldMuteNestedMainRun)
     Log::setSilent(true);
+  // The single thread need not be this one (see runPartitionTask).
+  const bool muteTasks = Log::isThreadMuted();
 
   {
-    // Spawn the largest modules first so the dominant subtrees start immediately
-    std::vector<PartitionQueue::size_t> spawnOrder(partitionQueue.size());
-    std::iota(spawnOrder.begin(), spawnOrder.end(), PartitionQueue::size_t { 0 });
-    std::sort(spawnOrder.begin(), spawnOrder.end(), [&partitionQueue](PartitionQueue::size_t a, PartitionQueue::size_t b) {
-      return partitionQueue[a]->data.flow > partitionQueue[b]->data.flow;
-    });
+    std::vector<InfoNode*> modules(partitionQueue.size());
+    for (PartitionQueue::size_t i = 0; i < partitionQueue.size(); ++i)
+      modules[i] = partitionQueue[i];
 
 #ifdef _OPENMP
 #pragma omp parallel
 #pragma omp single
 #endif
     {
-      for (auto moduleIndex : spawnOrder) {
-        // Stop spawning once cancelled; never throw inside the task region (#412).
-        if (interruptRequested())
-          break;
-        InfoNode* module = partitionQueue[moduleIndex];
-        detail::PartitionTaskRecord* record = &rootRecords[moduleIndex];
-#ifdef _OPENMP
-#pragma omp task firstprivate(module, record)
-#endif
-        partitionModuleRecursively(*module, startLevel, *record);
-      }
+      Log::ScopedMute muteSpawn(muteTasks);
+      spawnPartitionTasks(modules, startLevel, rootRecords.data());
 #ifdef _OPENMP
 #pragma omp taskwait
 #endif
@@ -3193,6 +3551,130 @@ void InfomapBase::queueLeafModules(PartitionQueue& partitionQueue)
   partitionQueue.level = maxDepth;
 }
 
+namespace {
+
+  // Modules with at most this many children are partitioned by enumerating all
+  // their set partitions under --exact-small-modules: Bell(8) = 4140 candidates,
+  // each scored from per-subset terms in at most eight additions.
+  constexpr unsigned int maxChildDegreeForExactPartition = 8;
+
+  struct SmallModulePartition {
+    std::array<unsigned int, maxChildDegreeForExactPartition> blockOf {};
+    unsigned int numBlocks = 0;
+    double codelength = std::numeric_limits<double>::max();
+    double indexCodelength = 0.0;
+  };
+
+  // The two-level partition of a module's children with the shortest map
+  // equation codelength, where the module is a sub-network whose exit flow
+  // leaves it entirely, as for a sub-Infomap initialized on it. A subset's
+  // enter and exit flow are those of its members less the flow on the links
+  // among them; self-links are left out as in the optimizer.
+  SmallModulePartition findOptimalSmallModulePartition(InfoNode& module)
+  {
+    using infomath::plogp;
+    const unsigned int numNodes = module.childDegree();
+    std::array<InfoNode*, maxChildDegreeForExactPartition> nodes {};
+    unsigned int nodeIndex = 0;
+    for (InfoNode& node : module)
+      nodes[nodeIndex++] = &node;
+
+    // Per-subset flow, enter and exit, built up one member at a time
+    constexpr unsigned int maxNumSubsets = 1u << maxChildDegreeForExactPartition;
+    const unsigned int numSubsets = 1u << numNodes;
+    std::array<std::array<double, maxChildDegreeForExactPartition>, maxChildDegreeForExactPartition> linkFlow {};
+    for (unsigned int i = 0; i < numNodes; ++i) {
+      for (InfoEdge* e : nodes[i]->outEdges()) {
+        for (unsigned int j = 0; j < numNodes; ++j) {
+          if (j != i && e->target == nodes[j]) {
+            linkFlow[i][j] += e->data.flow;
+            linkFlow[j][i] += e->data.flow;
+          }
+        }
+      }
+    }
+    std::array<double, maxNumSubsets> flow {};
+    std::array<double, maxNumSubsets> enter {};
+    std::array<double, maxNumSubsets> exit {};
+    std::array<double, maxNumSubsets> subsetTerm {};
+    std::array<double, maxNumSubsets> enterTerm {};
+    for (unsigned int subset = 1; subset < numSubsets; ++subset) {
+      unsigned int i = 0;
+      while (!(subset & (1u << i)))
+        ++i;
+      const unsigned int rest = subset & (subset - 1);
+      double internalFlow = 0.0;
+      for (unsigned int j = i + 1; j < numNodes; ++j) {
+        if (rest & (1u << j))
+          internalFlow += linkFlow[i][j];
+      }
+      flow[subset] = flow[rest] + nodes[i]->data.flow;
+      enter[subset] = enter[rest] + nodes[i]->data.enterFlow - internalFlow;
+      exit[subset] = exit[rest] + nodes[i]->data.exitFlow - internalFlow;
+      subsetTerm[subset] = plogp(flow[subset] + exit[subset]) - plogp(exit[subset]) - plogp(enter[subset]);
+      enterTerm[subset] = plogp(enter[subset]);
+    }
+
+    double nodeFlowLogNodeFlow = 0.0;
+    for (unsigned int i = 0; i < numNodes; ++i)
+      nodeFlowLogNodeFlow += plogp(nodes[i]->data.flow);
+    const double exitNetworkFlow = module.data.exitFlow;
+    const double exitNetworkFlowLogExitNetworkFlow = plogp(exitNetworkFlow);
+
+    // Walk the restricted growth strings: node i joins one of the blocks of
+    // nodes 0..i-1 or opens a new one, so each set partition is visited once.
+    SmallModulePartition best;
+    std::array<unsigned int, maxChildDegreeForExactPartition> blockOf {};
+    std::array<unsigned int, maxChildDegreeForExactPartition> blocks {};
+    const auto visit = [&](unsigned int numBlocks) {
+      double sumEnter = 0.0;
+      double sumSubsetTerms = 0.0;
+      double sumEnterTerms = 0.0;
+      for (unsigned int b = 0; b < numBlocks; ++b) {
+        sumEnter += enter[blocks[b]];
+        sumSubsetTerms += subsetTerm[blocks[b]];
+        sumEnterTerms += enterTerm[blocks[b]];
+      }
+      const double enterFlowLogEnterFlow = plogp(sumEnter + exitNetworkFlow);
+      const double codelength = enterFlowLogEnterFlow - exitNetworkFlowLogExitNetworkFlow + sumSubsetTerms - nodeFlowLogNodeFlow;
+      if (codelength < best.codelength) {
+        best.codelength = codelength;
+        best.indexCodelength = enterFlowLogEnterFlow - sumEnterTerms - exitNetworkFlowLogExitNetworkFlow;
+        best.blockOf = blockOf;
+        best.numBlocks = numBlocks;
+      }
+    };
+    const auto assign = [&](const auto& self, unsigned int i, unsigned int numBlocks) -> void {
+      if (i == numNodes) {
+        visit(numBlocks);
+        return;
+      }
+      for (unsigned int b = 0; b <= numBlocks; ++b) {
+        blockOf[i] = b;
+        blocks[b] |= 1u << i;
+        self(self, i + 1, b == numBlocks ? numBlocks + 1 : numBlocks);
+        blocks[b] &= ~(1u << i);
+      }
+    };
+    assign(assign, 0, 0);
+    return best;
+  }
+
+} // namespace
+
+bool InfomapBase::canPartitionModuleExactly(const InfoNode& module) const
+{
+  // The enumeration scores the plain first-order map equation on leaf nodes;
+  // other objectives and bias terms keep the sub-Infomap.
+  return exactSmallModules
+      && module.childDegree() <= maxChildDegreeForExactPartition
+      && module.isLeafModule()
+      && m_optimizerKind == BiasedOptimizer
+      && !recordedTeleportation
+      && !entropyBiasCorrection
+      && preferredNumberOfModules == 0;
+}
+
 void InfomapBase::partitionModuleRecursively(InfoNode& module, unsigned int level, detail::PartitionTaskRecord& record) const
 {
   module.codelength = calcCodelength(module);
@@ -3216,6 +3698,16 @@ void InfomapBase::partitionModuleRecursively(InfoNode& module, unsigned int leve
 
   double oldModuleCodelength = module.codelength;
 
+  // #308: bias the refinement accept test by the local recursion depth (level + 1).
+  const double subPrefBias = twoLevel
+      ? 0.0
+      : prefLevelsBias(preferredNumberOfLevels, preferredNumberOfLevelsStrength, level + 1);
+
+  if (canPartitionModuleExactly(module)) {
+    partitionSmallModuleExactly(module, level, oldModuleCodelength - minimumCodelengthImprovement + subPrefBias, record);
+    return;
+  }
+
   auto& subInfomap = getSubInfomap(module)
                          .initNetwork(module);
   // Run two-level partition + find hierarchically super modules (skip recursion).
@@ -3236,10 +3728,6 @@ void InfomapBase::partitionModuleRecursively(InfoNode& module, unsigned int leve
   InfoNode& subRoot = *module.getInfomapRoot();
   unsigned int numSubModules = subRoot.childDegree();
   bool trivialSubPartition = numSubModules == 1 || numSubModules == module.childDegree();
-  // #308: bias the refinement accept test by the local recursion depth (level + 1).
-  const double subPrefBias = twoLevel
-      ? 0.0
-      : prefLevelsBias(preferredNumberOfLevels, preferredNumberOfLevelsStrength, level + 1);
   bool improvedCodelength = subCodelength < oldModuleCodelength - minimumCodelengthImprovement + subPrefBias;
 
   if (trivialSubPartition || !improvedCodelength) {
@@ -3258,8 +3746,6 @@ void InfomapBase::partitionModuleRecursively(InfoNode& module, unsigned int leve
   record.queueFlow = subQueue.flow;
 
   const auto numSubModulesQueued = subQueue.size();
-  // Sized once before spawning so child records have stable addresses
-  record.children.resize(numSubModulesQueued);
 
   // Materialize this sub-partition into real children of `module`, then dispose
   // the sub-Infomap so its working set (cloned active network + pools + maps) is
@@ -3335,35 +3821,136 @@ void InfomapBase::partitionModuleRecursively(InfoNode& module, unsigned int leve
     module.disposeInfomap();
   }
 
-  // Spawn the largest sub-modules first so the dominant subtrees start immediately.
+  spawnSubModulePartitions(materializedSubModules, level, record);
+}
+
+void InfomapBase::partitionSmallModuleExactly(InfoNode& module, unsigned int level, double acceptBelowCodelength, detail::PartitionTaskRecord& record) const
+{
+  const SmallModulePartition best = findOptimalSmallModulePartition(module);
+  // Same accept test as for a sub-Infomap result. The optimum being trivial
+  // means any split a sub-Infomap could settle on is worse than the trivial one.
+  const bool trivialSubPartition = best.numBlocks == 1 || best.numBlocks == module.childDegree();
+  if (trivialSubPartition || !(best.codelength < acceptBelowCodelength)) {
+    record.leafCodelength = module.codelength;
+    return;
+  }
+
+  std::vector<InfoNode*> originalLeaves;
+  originalLeaves.reserve(module.childDegree());
+  for (auto& child : module)
+    originalLeaves.push_back(&child);
+
+  module.releaseChildren();
+
+  // Raw `new` as for the materialized sub-Infomap modules above.
+  std::vector<InfoNode*> subModules(best.numBlocks, nullptr);
+  for (auto& subModule : subModules)
+    subModule = new InfoNode();
+  for (std::size_t i = 0; i < originalLeaves.size(); ++i) {
+    InfoNode& subModule = *subModules[best.blockOf[i]];
+    subModule.data += originalLeaves[i]->data;
+    subModule.addChild(originalLeaves[i]);
+  }
+
+  double sumSubModuleCodelength = 0.0;
+  double queueFlow = 0.0;
+  for (InfoNode* subModule : subModules) {
+    // Enter and exit flow less the flow on the links within the sub-module
+    double internalFlow = 0.0;
+    for (InfoNode& node : *subModule) {
+      for (InfoEdge* e : node.outEdges()) {
+        if (e->target != &node && e->target->parent == subModule)
+          internalFlow += e->data.flow;
+      }
+    }
+    subModule->data.enterFlow -= internalFlow;
+    subModule->data.exitFlow -= internalFlow;
+    subModule->codelength = calcCodelength(*subModule);
+    sumSubModuleCodelength += subModule->codelength;
+    queueFlow += subModule->data.flow;
+    module.addChild(subModule);
+  }
+
+  record.indexCodelength = best.indexCodelength;
+  record.moduleCodelength = sumSubModuleCodelength;
+  record.queueFlow = queueFlow;
+  module.codelength = best.indexCodelength;
+
+  spawnSubModulePartitions(subModules, level, record);
+}
+
+void InfomapBase::spawnSubModulePartitions(std::vector<InfoNode*>& materializedSubModules, unsigned int level, detail::PartitionTaskRecord& record) const
+{
+  const auto numSubModulesQueued = materializedSubModules.size();
+  // Sized once before spawning so child records have stable addresses
+  record.children.resize(numSubModulesQueued);
+
   // Children recurse into the materialized real nodes (disjoint subtrees, no shared
-  // sub-Infomap), so the task graph is unchanged and no taskwait is needed.
-  std::vector<PartitionQueue::size_t> spawnOrder(numSubModulesQueued);
-  std::iota(spawnOrder.begin(), spawnOrder.end(), PartitionQueue::size_t { 0 });
-  std::sort(spawnOrder.begin(), spawnOrder.end(), [&materializedSubModules](PartitionQueue::size_t a, PartitionQueue::size_t b) {
-    return materializedSubModules[a]->data.flow > materializedSubModules[b]->data.flow;
+  // sub-Infomap), so no taskwait is needed.
+  spawnPartitionTasks(materializedSubModules, level + 1, record.children.data());
+  // No taskwait needed: child tasks only write their own records, which outlive
+  // them, and all tasks complete before the spawning parallel region ends.
+}
+
+void InfomapBase::spawnPartitionTasks(const std::vector<InfoNode*>& modules, unsigned int level, detail::PartitionTaskRecord* records) const
+{
+  // Spawn the largest modules first so the dominant subtrees start immediately
+  std::vector<std::size_t> spawnOrder(modules.size());
+  std::iota(spawnOrder.begin(), spawnOrder.end(), std::size_t { 0 });
+  std::sort(spawnOrder.begin(), spawnOrder.end(), [&modules](std::size_t a, std::size_t b) {
+    return modules[a]->data.flow > modules[b]->data.flow;
   });
 
-  for (auto subModuleIndex : spawnOrder) {
-    // Stop spawning once cancelled (in-flight children bail at their own check).
+  // Modules below the grain are batched into one task until their children
+  // reach it, so deep hierarchies of tiny modules don't pay task creation and
+  // scheduling per module. A remainder below the grain costs more to schedule
+  // and steal than to run here.
+  std::vector<std::pair<InfoNode*, detail::PartitionTaskRecord*>> batch;
+  unsigned int batchChildDegree = 0;
+  for (auto moduleIndex : spawnOrder) {
+    // Stop spawning once cancelled (in-flight tasks bail at their own check).
     if (interruptRequested())
-      break;
-    InfoNode* subModule = materializedSubModules[subModuleIndex];
-    detail::PartitionTaskRecord* childRecord = &record.children[subModuleIndex];
-    // Small subtrees run inline: spawning them as tasks costs more in task
-    // scheduling and idle-thread stealing than their work is worth.
-    // NOLINTNEXTLINE(bugprone-branch-clone) -- the branches differ by the task pragma
-    if (subModule->childDegree() < minChildDegreeForPartitionTask) {
-      partitionModuleRecursively(*subModule, level + 1, *childRecord);
-    } else {
+      return;
+    InfoNode* module = modules[moduleIndex];
+    const unsigned int childDegree = module->childDegree();
+    if (childDegree >= partitionTaskGrain) {
+      runPartitionTask({ { module, &records[moduleIndex] } }, level);
+      continue;
+    }
+    batch.emplace_back(module, &records[moduleIndex]);
+    batchChildDegree += childDegree;
+    if (batchChildDegree >= partitionTaskGrain) {
+      runPartitionTask(std::move(batch), level);
+      batch.clear();
+      batchChildDegree = 0;
+    }
+  }
+
+  for (auto& [module, record] : batch) {
+    if (interruptRequested())
+      return;
+    partitionModuleRecursively(*module, level, *record);
+  }
+}
+
+void InfomapBase::runPartitionTask(std::vector<std::pair<InfoNode*, detail::PartitionTaskRecord*>> task, unsigned int level) const
+{
+  m_partitionTaskStats->created.fetch_add(1, std::memory_order_relaxed);
+  // A muted parallel-trial worker runs its recursion on a team of its own, so
+  // carry its mute over to whichever thread picks up the task.
+  const bool muted = Log::isThreadMuted();
 #ifdef _OPENMP
-#pragma omp task firstprivate(subModule, childRecord)
+#pragma omp task firstprivate(task, level, muted)
 #endif
-      partitionModuleRecursively(*subModule, level + 1, *childRecord);
+  {
+    Log::ScopedMute muteTask(muted);
+    m_partitionTaskStats->executed.fetch_add(1, std::memory_order_relaxed);
+    for (auto& [module, record] : task) {
+      if (interruptRequested())
+        break;
+      partitionModuleRecursively(*module, level, *record);
     }
   }
-  // No taskwait needed: child tasks only write their own records, which outlive
-  // them, and all tasks complete before the spawning parallel region ends.
 }
 
 // ===================================================
@@ -3498,30 +4085,118 @@ void InfomapBase::initOptimizer(bool forceNoMemory)
       throw std::runtime_error("--lossy requires undirected flow");
   }
 #endif
-  if (haveMetaData()) {
+  m_optimizerKind = optimizerKind(*this, forceNoMemory);
+  switch (m_optimizerKind) {
+  case MetaOptimizer:
     m_optimizer = std::make_unique<InfomapOptimizer<MetaMapEquation>>();
-  } else if (haveMemory() && !forceNoMemory) {
-#if INFOMAP_FEATURE_REGULARIZED_MULTILAYER
-    if (isRegularizedMultilayerFlow()) {
-      m_optimizer = std::make_unique<InfomapOptimizer<RegularizedMultilayerMapEquation>>();
-    } else {
-      m_optimizer = std::make_unique<InfomapOptimizer<MemMapEquation>>();
-    }
-#else
+    break;
+  case MemOptimizer:
     m_optimizer = std::make_unique<InfomapOptimizer<MemMapEquation>>();
+    break;
+#if INFOMAP_FEATURE_REGULARIZED_MULTILAYER
+  case RegularizedMultilayerOptimizer:
+    m_optimizer = std::make_unique<InfomapOptimizer<RegularizedMultilayerMapEquation>>();
+    break;
 #endif
-  } else {
 #if INFOMAP_FEATURE_LOSSY_MAP_EQUATION
-    if (lossy) {
-      m_optimizer = std::make_unique<InfomapOptimizer<LossyMapEquation>>();
-    } else {
-      m_optimizer = std::make_unique<InfomapOptimizer<BiasedMapEquation>>();
-    }
-#else
-    m_optimizer = std::make_unique<InfomapOptimizer<BiasedMapEquation>>();
+  case LossyOptimizer:
+    m_optimizer = std::make_unique<InfomapOptimizer<LossyMapEquation>>();
+    break;
 #endif
+  default:
+    m_optimizer = std::make_unique<InfomapOptimizer<BiasedMapEquation>>();
+    break;
   }
   m_optimizer->init(this);
 }
 
+// ===================================================
+// Sub-Infomap recycling
+// ===================================================
+
+InfomapBase* InfomapBase::getNewInfomapInstance() const
+{
+  m_subInfomapStats->instances.fetch_add(1, std::memory_order_relaxed);
+  InfomapBase* recycled = t_subInfomapPool.pop();
+  if (recycled == nullptr)
+    return new InfomapBase(getConfig());
+  try {
+    recycled->reinitFromConfig(getConfig());
+  } catch (...) {
+    delete recycled;
+    throw;
+  }
+  m_subInfomapStats->reused.fetch_add(1, std::memory_order_relaxed);
+  return recycled;
+}
+
+void InfomapBase::releaseSubInfomap(InfomapBase* infomap) noexcept
+{
+  if (infomap == nullptr)
+    return;
+  const bool recyclable = infomap->resetForReuse()
+      && infomap->m_nodePool.capacity() <= SubInfomapPool::maxNodeCapacity
+      && infomap->m_edgePool.capacity() <= SubInfomapPool::maxEdgeCapacity;
+  if (!recyclable || !t_subInfomapPool.push(infomap))
+    delete infomap;
+}
+
+bool InfomapBase::resetForReuse() noexcept
+{
+  m_root.disposeInfomap();
+  m_root.deleteChildren();
+  // Copy-assignment leaves the pool pointers, the owner and the state nodes alone.
+  m_root = InfoNode();
+  m_root.owner = nullptr;
+  m_root.stateNodes.clear();
+  if (m_nodePool.liveCount() != 0 || m_edgePool.liveCount() != 0)
+    return false;
+
+  m_leafNodes.clear();
+  m_moduleNodes.clear();
+  m_activeNetwork = nullptr;
+  m_originalLeafNodes.clear();
+  m_initialPartition.clear();
+  m_multilayerInitialPartition.clear();
+  m_isMain = true;
+  m_subLevel = 0;
+  m_calculateEnterExitFlow = false;
+  m_oneLevelCodelength = 0.0;
+  m_numNonTrivialTopModules = 0;
+  m_tuneIterationIndex = 0;
+  m_isCoarseTune = false;
+  m_isParallelFineTune = false;
+  m_isParallelSuperLevel = false;
+  m_fineTunedModules.clear();
+  m_aggregationLevel = 0;
+  m_hierarchicalCodelength = 0.0;
+  m_codelengths.clear();
+  m_numTopModules.clear();
+  m_entropyRate = 0.0;
+  m_maxEntropy = 0.0;
+  m_maxFlow = 0.0;
+  m_sumDanglingFlow = 0.0;
+  m_cancelRequested.store(false, std::memory_order_relaxed);
+  m_cancel = &m_cancelRequested;
+  m_interruptCallback = nullptr;
+  m_interruptUserData = nullptr;
+  m_subInfomapStats = &m_subInfomapStatsStorage;
+  m_partitionTaskStats = &m_partitionTaskStatsStorage;
+  m_optimizer->resetForReuse();
+  return true;
+}
+
+void InfomapBase::reinitFromConfig(const Config& conf)
+{
+  static_cast<Config&>(*this) = conf;
+  // A fresh default engine, as the constructor makes, so an engine injected
+  // into an earlier run tree is neither kept nor reseeded here.
+  m_rand = Random(conf.seedToRandomNumberGenerator);
+  m_network.setConfig(conf);
+  if (optimizerKind(conf, false) == m_optimizerKind)
+    m_optimizer->init(this);
+  else
+    initOptimizer();
+}
+
 } // namespace infomap
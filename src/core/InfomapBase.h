@@ -23,6 +23,7 @@
 #include "../utils/Date.h"
 #include "../utils/Stopwatch.h"
 
+#include <algorithm>
 #include <vector>
 #include <deque>
 #include <map>
@@ -41,6 +42,32 @@ namespace detail {
   class PartitionQueue;
   struct PartitionTaskRecord;
   struct PerLevelStat;
+
+  // Sub-Infomap instances created during one run, and how many of them were
+  // recycled from a thread's pool instead of allocated. Shared by the run tree
+  // through inheritRuntimeContext, like the cancel flag.
+  struct SubInfomapPoolStats {
+    std::atomic<unsigned long long> instances { 0 };
+    std::atomic<unsigned long long> reused { 0 };
+  };
+
+  // OpenMP tasks the recursive partition spawned during one run, and how many
+  // of them ran. Shared like SubInfomapPoolStats, so parallel-trial workers add
+  // to the main instance's counts.
+  struct PartitionTaskStats {
+    std::atomic<unsigned long long> created { 0 };
+    std::atomic<unsigned long long> executed { 0 };
+  };
+
+  // The threads of a parallel-trial run left over beyond one per worker. The
+  // workers with trials still to run split them evenly, so as workers run out
+  // of trials the remaining ones take over their threads.
+  struct TrialThreadShare {
+    unsigned int totalThreads = 1;
+    std::atomic<unsigned int> activeWorkers { 1 };
+
+    unsigned int threadsPerWorker() const { return std::max(1u, totalThreads / std::max(1u, activeWorkers.load(std::memory_order_relaxed))); }
+  };
 } // namespace detail
 
 // Cooperative cancellation hook (issue #412). Return true to stop the run at the
@@ -55,6 +82,14 @@ public:
   InterruptionError() : std::runtime_error("Infomap run interrupted.") {}
 };
 
+// Thrown at a pruning checkpoint of a parallel trial (--prune-trials) that has
+// fallen too far behind the best trial at that stage. Caught by the trial worker.
+class TrialAbandoned : public std::runtime_error {
+public:
+  explicit TrialAbandoned(double codelength) : std::runtime_error("Trial abandoned."), codelength(codelength) {}
+  double codelength; // at the checkpoint
+};
+
 class InfomapBase : public InfomapConfig<InfomapBase> {
   template <typename Objective>
   friend class InfomapOptimizer;
@@ -236,6 +271,10 @@ public:
 
   void run(Network& network);
 
+  // Return a sub-Infomap to the calling thread's pool, or delete it if the
+  // pool is full or the instance is too large to be worth keeping.
+  static void releaseSubInfomap(InfomapBase* infomap) noexcept;
+
   // ===================================================
   // Cooperative interruption (issue #412)
   // ===================================================
@@ -284,7 +323,10 @@ private:
   bool isFullNetwork() const { return m_isMain && m_aggregationLevel == 0; }
   bool isFirstLoop() const { return m_tuneIterationIndex == 0 && isFullNetwork(); }
 
-  InfomapBase* getNewInfomapInstance() const { return new InfomapBase(getConfig()); }
+  // A sub-Infomap for this run's config, recycled from the calling thread's
+  // pool when it holds one. Pair with releaseSubInfomap, which InfoNode's
+  // disposeInfomap calls, instead of delete.
+  InfomapBase* getNewInfomapInstance() const;
   InfomapBase* getNewInfomapInstanceWithoutMemory() const
   {
     auto im = new InfomapBase();
@@ -318,6 +360,7 @@ private:
     // its codelength directly against this instance's index codelength, and the two are only
     // comparable when both objectives are configured alike (#904).
     superInfomap.m_optimizer->inheritObjectiveParametersFrom(*m_optimizer);
+    superInfomap.m_isParallelSuperLevel = parallelSuperModules;
     return superInfomap;
   }
 
@@ -344,11 +387,13 @@ private:
 
   bool haveHardPartition() const { return !m_originalLeafNodes.empty(); }
 
-  // Share the cancel flag (only) with a sub/worker Infomap. The callback is NOT
+  // Share the cancel flag and the run counters with a sub/worker Infomap. The callback is NOT
   // inherited — only the main instance, on the owner thread, ever invokes it.
   InfomapBase& inheritRuntimeContext(const InfomapBase& other)
   {
     m_cancel = other.m_cancel;
+    m_subInfomapStats = other.m_subInfomapStats;
+    m_partitionTaskStats = other.m_partitionTaskStats;
     return *this;
   }
 
@@ -360,6 +405,38 @@ private:
       throw InterruptionError();
   }
 
+  // Pruning checkpoints of a parallel trial (--prune-trials): give up on it if
+  // this codelength trails the best at the same stage by more than the margin.
+  // Each stage compares with its own best, since the hierarchy can save more
+  // than the margin on the two-level codelength. Like checkCancelled, call them
+  // only where a throw can unwind legally.
+
+  // After partition(): the best two-level codelength of the trials so far,
+  // which this one then joins.
+  void abandonTrialIfBehindTwoLevel(double codelength) const
+  {
+    if (m_bestTwoLevelTrialCodelength == nullptr)
+      return;
+    auto best = m_bestTwoLevelTrialCodelength->load(std::memory_order_relaxed);
+    if (codelength > best * (1.0 + pruneTrialsMargin))
+      throw TrialAbandoned(codelength);
+    while (codelength < best && !m_bestTwoLevelTrialCodelength->compare_exchange_weak(best, codelength, std::memory_order_relaxed)) { }
+  }
+
+  // After findHierarchicalSuperModules(): the best finished trial.
+  void abandonTrialIfBehindHierarchical(double codelength) const
+  {
+    if (m_bestTrialCodelength == nullptr)
+      return;
+    if (codelength > m_bestTrialCodelength->load(std::memory_order_relaxed) * (1.0 + pruneTrialsMargin))
+      throw TrialAbandoned(codelength);
+  }
+
+  // Size this parallel-trial worker's inner teams to its current share of the
+  // threads. A no-op outside a hybrid parallel-trial run; called at the points
+  // between optimization phases, where no team of the worker is open.
+  void adoptTrialThreadShare() const;
+
   // The thread-id guard keeps the callback off worker threads even when this
   // object's methods run inside the task graph (off-thread it is a flag check).
   void pollInterrupt()
@@ -511,6 +588,8 @@ private:
 
   unsigned int fineTune();
 
+  void markLeafNodesNearChangedModulesDirty(const std::vector<unsigned int>& modules, unsigned int numModules);
+
   unsigned int coarseTune();
 
   /**
@@ -579,6 +658,21 @@ private:
 
   void partitionModuleRecursively(InfoNode& module, unsigned int level, detail::PartitionTaskRecord& record) const;
 
+  bool canPartitionModuleExactly(const InfoNode& module) const;
+
+  // Partition a module of at most eight leaves by enumerating its set partitions
+  // (--exact-small-modules), keeping the best split if its codelength is below
+  // acceptBelowCodelength, and recurse into the new sub-modules.
+  void partitionSmallModuleExactly(InfoNode& module, unsigned int level, double acceptBelowCodelength, detail::PartitionTaskRecord& record) const;
+
+  void spawnSubModulePartitions(std::vector<InfoNode*>& materializedSubModules, unsigned int level, detail::PartitionTaskRecord& record) const;
+
+  // Partition modules[i] into records[i], largest flow first, in OpenMP tasks
+  // of at least partitionTaskGrain children each.
+  void spawnPartitionTasks(const std::vector<InfoNode*>& modules, unsigned int level, detail::PartitionTaskRecord* records) const;
+
+  void runPartitionTask(std::vector<std::pair<InfoNode*, detail::PartitionTaskRecord*>> task, unsigned int level) const;
+
 public:
   // ===================================================
   // Output: *
@@ -636,6 +730,16 @@ private:
 
   void printDebug() const { return m_optimizer->printDebug(); }
 
+  // Tear down a finished sub-run so the instance can be recycled: free the
+  // tree back to the node and edge pools and clear the per-run state, keeping
+  // the capacity of the pools and the scratch buffers. Returns false if the
+  // tree did not give back every node and edge, in which case the instance
+  // must be deleted instead.
+  bool resetForReuse() noexcept;
+
+  // Re-initialize a recycled instance as if constructed from conf.
+  void reinitFromConfig(const Config& conf);
+
   // ===================================================
   // Members
   // ===================================================
@@ -669,6 +773,14 @@ protected:
   unsigned int m_numNonTrivialTopModules = 0;
   unsigned int m_tuneIterationIndex = 0;
   bool m_isCoarseTune = false;
+  // Set during a --parallel-fine-tune fine-tune. The leaf partition each
+  // fine-tune ended with, as a module id per leaf, lets the next one revisit
+  // only the nodes near modules that changed since.
+  bool m_isParallelFineTune = false;
+  // Set on a super-level instance under --parallel-super-modules, and on
+  // this one while findHierarchicalSuperModulesFast optimizes a super network.
+  bool m_isParallelSuperLevel = false;
+  std::vector<unsigned int> m_fineTunedModules;
   unsigned int m_aggregationLevel = 0;
 
   double m_hierarchicalCodelength = 0.0;
@@ -695,7 +807,22 @@ protected:
   void* m_interruptUserData = nullptr;
   std::thread::id m_ownerThreadId;
 
+  detail::SubInfomapPoolStats m_subInfomapStatsStorage;
+  detail::SubInfomapPoolStats* m_subInfomapStats = &m_subInfomapStatsStorage;
+  detail::PartitionTaskStats m_partitionTaskStatsStorage;
+  detail::PartitionTaskStats* m_partitionTaskStats = &m_partitionTaskStatsStorage;
+  // The best codelength of the finished parallel trials, and the best
+  // two-level codelength any of them has reached, set on the workers of a
+  // --prune-trials run only.
+  const std::atomic<double>* m_bestTrialCodelength = nullptr;
+  std::atomic<double>* m_bestTwoLevelTrialCodelength = nullptr;
+  // Set on the workers of a parallel-trial run with threads to spare per worker.
+  detail::TrialThreadShare* m_trialThreadShare = nullptr;
+
   std::unique_ptr<InfomapOptimizerBase> m_optimizer;
+  // The objective m_optimizer was built for, so a recycled instance keeps its
+  // optimizer when the next config asks for the same one.
+  unsigned int m_optimizerKind = 0;
 };
 
 /**
@@ -106,8 +106,8 @@ public:
    *
    * The engine drives all draws except the opt-in inner-parallel move loop
    * (--inner-parallelization, default off), which uses per-node mt19937s
-   * seeded from the config seed — a host RNG is never shared across OpenMP
-   * worker threads.
+   * (per-block under --deterministic) seeded from the config seed — a host RNG
+   * is never shared across OpenMP worker threads.
    *
    * Example:
    *   im.setRandomEngine(MyEngine{});
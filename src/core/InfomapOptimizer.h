@@ -24,6 +24,9 @@
 #include <set>
 #include <utility>
 #include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
 #ifdef _OPENMP
@@ -36,6 +39,59 @@ namespace infomap {
 // (team fork/join, proposal buffers, serial commit pass) outweigh the work.
 constexpr unsigned int minNetworkSizeForInnerParallelization = 10000;
 
+namespace detail {
+  // Accumulate into a module flow field that other threads of the coloring
+  // sweep may update at the same time.
+  inline void atomicAdd(double& target, double value)
+  {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    target += value;
+  }
+
+  // A link between modules, with the network position of the node it leaves,
+  // which breaks ties to keep the serial summation order.
+  struct ModuleLink {
+    unsigned int target = 0;
+    unsigned int order = 0;
+    double flow = 0.0;
+  };
+
+  // The nesting level at which this thread may open a team of its own: the top
+  // level, except on a parallel-trial worker that runs its trial on a share of
+  // the threads one level down (see RunSession::runTrialsInParallel).
+  inline thread_local int t_ownTeamLevel = 0;
+
+  // Whether a parallel region opened here would get its own threads, rather
+  // than run nested inside a team that already has them.
+  inline bool canOpenTeam()
+  {
+#ifdef _OPENMP
+    return omp_get_active_level() == t_ownTeamLevel;
+#else
+    return false;
+#endif
+  }
+
+  // Split consolidateModules' link aggregation across a team when there is
+  // one to spare. The result is the same either way.
+  inline bool useParallelModuleAggregation(std::size_t numNodes)
+  {
+#ifdef _OPENMP
+    return canOpenTeam() && omp_get_max_threads() > 1 && numNodes >= minNetworkSizeForInnerParallelization;
+#else
+    (void)numNodes;
+    return false;
+#endif
+  }
+} // namespace detail
+
+// Enumeration positions per work item of the parallel move sweep. Fixed rather
+// than derived from the team size, so the blocks, and under --deterministic
+// their random streams, are the same for any thread count.
+constexpr unsigned int innerParallelMoveBlockSize = 512;
+
 template <typename Objective>
 class InfomapOptimizer : public InfomapOptimizerBase {
   using FlowDataType = typename Objective::FlowDataType;
@@ -47,6 +103,27 @@ public:
     m_infomap = infomap;
     m_objective.init(infomap->getConfig());
     m_innerParallelMoveSweep = 0;
+    m_colorStamp = 0;
+  }
+
+  void resetForReuse() noexcept override
+  {
+    m_objective = Objective();
+    m_consolidatedObjective = Objective();
+    // The stamps are compared against counters that init restarts from zero.
+    m_moduleTouchedSweep.clear();
+    m_moduleChangedColor.clear();
+    m_numColors = 0;
+    m_useActiveSet = false;
+    m_haveLeafAdjacency = false;
+  }
+
+  void restartSweeps() noexcept override
+  {
+    m_innerParallelMoveSweep = 0;
+    m_colorStamp = 0;
+    m_moduleTouchedSweep.clear();
+    m_moduleChangedColor.clear();
   }
 
   // ===================================================
@@ -105,16 +182,48 @@ protected:
 
   void moveActiveNodesToPredefinedModules(std::vector<unsigned int>& modules) override;
 
-  bool moveNodeToPredefinedModule(InfoNode& current, unsigned int module);
+  bool moveNodeToPredefinedModule(unsigned int nodeIndex, unsigned int module);
+
+  void initActiveAdjacency();
 
   unsigned int optimizeActiveNetwork() override;
 
   bool shouldUseInnerParallelization() const;
 
+  bool shouldUseColoringSweep() const;
+
   unsigned int tryMoveEachNodeIntoBestModule() override;
 
+  unsigned int tryMoveNodeIntoBestModule(unsigned int nodeIndex, unsigned int numRandomMoves);
+
+  unsigned int tryMoveEachActiveNodeIntoBestModule();
+
+  void markDirty(unsigned int nodeIndex);
+
+  void markNeighboursDirty(unsigned int nodeIndex);
+
+  void initActiveSet(bool parallel);
+
+  void updateActiveSetAfterParallelSweep();
+
   unsigned int tryMoveEachNodeIntoBestModuleInParallel() override;
 
+  unsigned int tryMoveEachNodeIntoBestModuleByColor() override;
+
+  bool prepareParallelMoveSweep();
+
+  void proposeMove(unsigned int i,
+                   bool useRandomMoves,
+                   unsigned int parallelMoveSweep,
+                   VectorMap<DeltaFlowDataType>& deltaFlow,
+                   std::vector<unsigned int>& moduleEnumeration,
+                   DeltaBatchScratch& deltaBatch,
+                   Random& blockRand);
+
+  void colorActiveNetwork();
+
+  void updateCodelengthOnColorMoves();
+
   void consolidateModules(bool replaceExistingModules = true) override;
 
   bool restoreConsolidatedOptimizationPointIfNoImprovement(bool forceRestore = false) override;
@@ -146,6 +255,9 @@ protected:
     bool targetWasEmpty = false;
     // Deltas against the sweep-start snapshot, applicable directly at commit
     // time as long as neither module has been touched earlier in the commit.
+    // Additive per-module aggregates kept by the objective itself (the lossy
+    // loss/entropy sums) follow from the node alone and are applied by
+    // updateCodelengthOnMovingNode against the aggregates as committed so far.
     DeltaFlowDataType oldDelta;
     DeltaFlowDataType newDelta;
   };
@@ -155,8 +267,10 @@ protected:
   std::vector<unsigned int> m_nodeEnumeration;
   std::vector<unsigned int> m_moduleEnumeration;
   VectorMap<DeltaFlowDataType> m_deltaFlow;
+  DeltaBatchScratch m_deltaBatch;
   std::vector<VectorMap<DeltaFlowDataType>> m_threadDeltaFlow;
   std::vector<std::vector<unsigned int>> m_threadModuleEnumeration;
+  std::vector<DeltaBatchScratch> m_threadDeltaBatch;
   std::vector<ParallelMoveProposal> m_moveProposals;
   std::vector<unsigned int> m_randomMoveTargets;
   std::vector<unsigned int> m_randomMoveTargetOffsets;
@@ -165,6 +279,39 @@ protected:
   // letting later proposals in the same commit skip the recheck when both of
   // their modules are unchanged since the sweep-start snapshot.
   std::vector<unsigned int> m_moduleTouchedSweep;
+  // Coloring sweep: a distance-1 coloring of the active network, the sweep's
+  // enumeration positions bucketed by color, and the modules one color changed
+  // with their flow data and member counts before its moves, stamped per color.
+  std::vector<unsigned int> m_nodeColor;
+  unsigned int m_numColors = 0;
+  std::vector<unsigned int> m_colorPositions;
+  std::vector<unsigned int> m_colorPositionOffsets;
+  std::vector<unsigned int> m_changedModules;
+  std::vector<FlowDataType> m_changedModuleFlowBefore;
+  std::vector<unsigned int> m_changedModuleMembersBefore;
+  std::vector<unsigned int> m_moduleChangedColor;
+  unsigned int m_colorStamp = 0;
+  // Active set (--active-set): the network positions of the dirty nodes the
+  // next sweep visits. A node is dirty exactly when it is in the set.
+  bool m_useActiveSet = false;
+  std::vector<unsigned int> m_activePositions;
+  std::vector<unsigned int> m_nextActivePositions;
+  // Flat adjacency of the active network by network position: the out-links,
+  // then the in-links, of each node in the order of its edges, with the
+  // neighbour's position and the link flow in separate contiguous arrays. The
+  // sweeps read neighbour modules from m_nodeModule, which mirrors
+  // InfoNode::index for each position, instead of through the edge and node
+  // objects. Built by initPartition, and kept for the leaf network, whose
+  // links do not change after initNetwork.
+  std::vector<std::size_t> m_outLinkOffsets;
+  std::vector<unsigned int> m_outNeighbours;
+  std::vector<double> m_outFlows;
+  std::vector<std::size_t> m_inLinkOffsets;
+  std::vector<unsigned int> m_inNeighbours;
+  std::vector<double> m_inFlows;
+  std::vector<unsigned int> m_nodeModule;
+  bool m_haveLeafAdjacency = false;
+  bool m_leafAdjacencyIsHard = false;
 };
 
 // ===================================================
@@ -278,63 +425,61 @@ inline bool InfomapOptimizer<BiasedMapEquation>::implementsObjectiveParameters()
   return true;
 }
 
-template <>
-inline bool InfomapOptimizer<MetaMapEquation>::shouldUseInnerParallelization() const
+template <typename Objective>
+inline bool InfomapOptimizer<Objective>::shouldUseInnerParallelization() const
 {
-  // MetaMapEquation's delta evaluation mutates shared metadata state while
-  // testing moves, so the lock-free inner parallel loop is not thread-safe.
+  if (!m_infomap->innerParallelization && !m_infomap->m_isParallelFineTune && !m_infomap->m_isParallelSuperLevel)
+    return false;
+  // Deterministic mode picks the sweep from the network alone: the serial and
+  // parallel sweeps take different paths through the same moves, so a choice
+  // that depended on the thread budget or nesting would change the result.
+  if (m_infomap->deterministic)
+    return m_infomap->activeNetwork().size() >= minNetworkSizeForInnerParallelization;
+#ifdef _OPENMP
+  // Inside the recursive-partition tasks, or parallel trials without threads
+  // to spare for each trial, a nested team would run with one thread but
+  // still pay the region and buffer setup, so keep those on the serial path.
+  if (!detail::canOpenTeam())
+    return false;
+  // With a single OpenMP thread the parallel sweep has the same fixed costs
+  // (proposal buffers, separate commit pass) and no parallelism to pay for them.
+  if (omp_get_max_threads() < 2)
+    return false;
+  return m_infomap->activeNetwork().size() >= minNetworkSizeForInnerParallelization;
+#else
   return false;
+#endif
 }
 
-template <>
-inline bool InfomapOptimizer<MemMapEquation>::shouldUseInnerParallelization() const
+// The coloring sweep applies the moves of one color together, which is exact
+// only when a node's move changes nothing but the flow of its old and new
+// module by amounts that follow from its own links. Memory, meta-data, lossy
+// and regularized objectives keep module state that couples nodes without a
+// link between them, so they stay on the proposal/commit sweep.
+template <typename Objective>
+inline bool InfomapOptimizer<Objective>::shouldUseColoringSweep() const
 {
-  // MemMapEquation keeps extra physical-node state that is updated together
-  // with accepted moves. Keep it on the stable serial path until that state can
-  // be batched with the module-flow updates.
   return false;
 }
 
-#if INFOMAP_FEATURE_REGULARIZED_MULTILAYER
 template <>
-inline bool InfomapOptimizer<RegularizedMultilayerMapEquation>::shouldUseInnerParallelization() const
+inline bool InfomapOptimizer<BiasedMapEquation>::shouldUseColoringSweep() const
 {
-  // RegularizedMultilayerMapEquation extends the memory objective with layer
-  // teleportation state. Keep it on the stable serial path until those updates
-  // can be batched with module-flow and physical-node updates.
-  return false;
+  // Recorded teleportation couples every pair of nodes through the module
+  // teleportation flow.
+  return m_infomap->innerParallelStrategy == "coloring" && !m_infomap->recordedTeleportation;
 }
-#endif
 
-#if INFOMAP_FEATURE_LOSSY_MAP_EQUATION
-template <>
-inline bool InfomapOptimizer<LossyMapEquation>::shouldUseInnerParallelization() const
+template <typename Objective>
+inline void InfomapOptimizer<Objective>::updateCodelengthOnColorMoves()
 {
-  // LossyMapEquation keeps per-module loss/entropy aggregates that are updated
-  // together with accepted moves; keep it on the serial path for now.
-  return false;
+  throw std::logic_error("InfomapOptimizer::updateCodelengthOnColorMoves(): the coloring sweep is not supported for this objective");
 }
-#endif
 
-template <typename Objective>
-inline bool InfomapOptimizer<Objective>::shouldUseInnerParallelization() const
+template <>
+inline void InfomapOptimizer<BiasedMapEquation>::updateCodelengthOnColorMoves()
 {
-  if (!m_infomap->innerParallelization)
-    return false;
-#ifdef _OPENMP
-  // Inside parallel trials or the recursive-partition tasks, a nested team
-  // would run with one thread but still pay the region and buffer setup,
-  // so keep nested instances on the serial path.
-  if (omp_in_parallel())
-    return false;
-  // With a single OpenMP thread the parallel sweep has the same fixed costs
-  // (proposal buffers, separate commit pass) and no parallelism to pay for them.
-  if (omp_get_max_threads() < 2)
-    return false;
-  return m_infomap->activeNetwork().size() >= minNetworkSizeForInnerParallelization;
-#else
-  return false;
-#endif
+  m_objective.updateCodelengthOnChangedModules(m_changedModules, m_changedModuleFlowBefore, m_changedModuleMembersBefore, m_moduleFlowData, m_moduleMembers);
 }
 
 // ===================================================
@@ -352,6 +497,7 @@ template <typename Objective>
 inline void InfomapOptimizer<Objective>::initNetwork()
 {
   Log(4) << "InfomapOptimizer::initNetwork()...\n";
+  m_haveLeafAdjacency = false;
   m_objective.initNetwork(m_infomap->root());
 
   if (!m_infomap->isMainInfomap())
@@ -362,6 +508,7 @@ template <typename Objective>
 inline void InfomapOptimizer<Objective>::initSuperNetwork()
 {
   Log(4) << "InfomapOptimizer::initSuperNetwork()...\n";
+  m_haveLeafAdjacency = false;
   m_objective.initSuperNetwork(m_infomap->root());
 }
 
@@ -382,18 +529,67 @@ void InfomapOptimizer<Objective>::initPartition()
   m_emptyModules.clear();
   m_emptyModules.reserve(numNodes);
 
+  m_nodeModule.resize(numNodes);
   unsigned int i = 0;
   for (auto& nodePtr : network) {
     InfoNode& node = *nodePtr;
     node.index = i; // Unique module index for each node
+    m_nodeModule[i] = i;
     m_moduleFlowData[i] = node.data;
     node.dirty = true;
     ++i;
   }
 
+  initActiveAdjacency();
+
   m_objective.initPartition(network);
 }
 
+template <typename Objective>
+void InfomapOptimizer<Objective>::initActiveAdjacency()
+{
+  auto& network = m_infomap->activeNetwork();
+  const bool isLeafNetwork = &network == &m_infomap->leafNodes();
+  // A hard partition swaps the leaf network for its modules, and restoring it
+  // swaps back, so the cached adjacency is only valid on the same side.
+  const bool isHardLeafNetwork = isLeafNetwork && m_infomap->haveHardPartition();
+  if (isLeafNetwork && m_haveLeafAdjacency && m_leafAdjacencyIsHard == isHardLeafNetwork)
+    return;
+  m_haveLeafAdjacency = isLeafNetwork;
+  m_leafAdjacencyIsHard = isHardLeafNetwork;
+
+  const auto numNodes = static_cast<unsigned int>(network.size());
+  m_outLinkOffsets.resize(numNodes + 1);
+  m_inLinkOffsets.resize(numNodes + 1);
+  m_outLinkOffsets[0] = 0;
+  m_inLinkOffsets[0] = 0;
+  for (unsigned int i = 0; i < numNodes; ++i) {
+    m_outLinkOffsets[i + 1] = m_outLinkOffsets[i] + network[i]->outDegree();
+    m_inLinkOffsets[i + 1] = m_inLinkOffsets[i] + network[i]->inDegree();
+  }
+  m_outNeighbours.resize(m_outLinkOffsets[numNodes]);
+  m_outFlows.resize(m_outLinkOffsets[numNodes]);
+  m_inNeighbours.resize(m_inLinkOffsets[numNodes]);
+  m_inFlows.resize(m_inLinkOffsets[numNodes]);
+
+  // initPartition has just numbered the nodes by position, so the neighbours'
+  // module index is their position here.
+  for (unsigned int i = 0; i < numNodes; ++i) {
+    std::size_t k = m_outLinkOffsets[i];
+    for (auto& e : network[i]->outEdges()) {
+      m_outNeighbours[k] = e->target->index;
+      m_outFlows[k] = e->data.flow;
+      ++k;
+    }
+    k = m_inLinkOffsets[i];
+    for (auto& e : network[i]->inEdges()) {
+      m_inNeighbours[k] = e->source->index;
+      m_inFlows[k] = e->data.flow;
+      ++k;
+    }
+  }
+}
+
 template <typename Objective>
 void InfomapOptimizer<Objective>::moveActiveNodesToPredefinedModules(std::vector<unsigned int>& modules)
 {
@@ -403,13 +599,14 @@ void InfomapOptimizer<Objective>::moveActiveNodesToPredefinedModules(std::vector
     throw std::length_error("Size of predefined modules differ from size of active network.");
 
   for (unsigned int i = 0; i < numNodes; ++i) {
-    moveNodeToPredefinedModule(*network[i], modules[i]);
+    moveNodeToPredefinedModule(i, modules[i]);
   }
 }
 
 template <typename Objective>
-bool InfomapOptimizer<Objective>::moveNodeToPredefinedModule(InfoNode& current, unsigned int newModule)
+bool InfomapOptimizer<Objective>::moveNodeToPredefinedModule(unsigned int nodeIndex, unsigned int newModule)
 {
+  InfoNode& current = *m_infomap->activeNetwork()[nodeIndex];
   unsigned int oldM = current.index;
   unsigned int newM = newModule;
 
@@ -421,26 +618,27 @@ bool InfomapOptimizer<Objective>::moveNodeToPredefinedModule(InfoNode& current,
   DeltaFlowDataType newModuleDelta(newM, 0.0, 0.0);
 
   // For all outlinks
-  for (auto& e : current.outEdges()) {
-    auto& edge = *e;
-    unsigned int otherModule = edge.target->index;
+  for (std::size_t k = m_outLinkOffsets[nodeIndex]; k < m_outLinkOffsets[nodeIndex + 1]; ++k) {
+    unsigned int otherModule = m_nodeModule[m_outNeighbours[k]];
     if (otherModule == oldM) {
-      oldModuleDelta.deltaExit += edge.data.flow;
+      oldModuleDelta.deltaExit += m_outFlows[k];
     } else if (otherModule == newM) {
-      newModuleDelta.deltaExit += edge.data.flow;
+      newModuleDelta.deltaExit += m_outFlows[k];
     }
   }
   // For all inlinks
-  for (auto& e : current.inEdges()) {
-    auto& edge = *e;
-    unsigned int otherModule = edge.source->index;
+  for (std::size_t k = m_inLinkOffsets[nodeIndex]; k < m_inLinkOffsets[nodeIndex + 1]; ++k) {
+    unsigned int otherModule = m_nodeModule[m_inNeighbours[k]];
     if (otherModule == oldM) {
-      oldModuleDelta.deltaEnter += edge.data.flow;
+      oldModuleDelta.deltaEnter += m_inFlows[k];
     } else if (otherModule == newM) {
-      newModuleDelta.deltaEnter += edge.data.flow;
+      newModuleDelta.deltaEnter += m_inFlows[k];
     }
   }
 
+  // For memory networks
+  m_objective.addMemoryContributions(current, oldModuleDelta, newModuleDelta);
+
   // For recorded teleportation
   m_objective.addTeleportationFlow(current, m_moduleFlowData, oldModuleDelta, newModuleDelta);
 
@@ -458,6 +656,7 @@ bool InfomapOptimizer<Objective>::moveNodeToPredefinedModule(InfoNode& current,
   m_moduleMembers[newM] += 1;
 
   current.index = newM;
+  m_nodeModule[nodeIndex] = newM;
   return true;
 }
 
@@ -475,14 +674,26 @@ INFOMAP_HOT inline unsigned int InfomapOptimizer<Objective>::optimizeActiveNetwo
     loopLimit = 20;
   }
 
+  // The active network does not change within the loop, so neither does the
+  // sweep, and a coloring is computed once per active network.
+  const bool useInnerParallelization = shouldUseInnerParallelization();
+  const bool useColoringSweep = useInnerParallelization && shouldUseColoringSweep();
+  if (useColoringSweep)
+    colorActiveNetwork();
+  // A parallel fine-tune has left dirty only the nodes near changed modules.
+  m_useActiveSet = (m_infomap->activeSet || m_infomap->m_isParallelFineTune) && !useColoringSweep;
+  if (m_useActiveSet)
+    initActiveSet(useInnerParallelization);
+
   do {
     // Cancellation checkpoint (#412): between the inner sweeps, so a throw here
     // never unwinds through an OpenMP region.
     m_infomap->pollInterrupt();
     ++coreLoopCount;
-    unsigned int numNodesMoved = shouldUseInnerParallelization()
-        ? tryMoveEachNodeIntoBestModuleInParallel()
-        : tryMoveEachNodeIntoBestModule();
+    unsigned int numNodesMoved = useColoringSweep ? tryMoveEachNodeIntoBestModuleByColor()
+        : useInnerParallelization                 ? tryMoveEachNodeIntoBestModuleInParallel()
+        : m_useActiveSet                          ? tryMoveEachActiveNodeIntoBestModule()
+                                                  : tryMoveEachNodeIntoBestModule();
     // Break if not enough improvement
     if (numNodesMoved == 0 || m_objective.getCodelength() >= oldCodelength - m_infomap->minimumCodelengthImprovement)
       break;
@@ -490,6 +701,7 @@ INFOMAP_HOT inline unsigned int InfomapOptimizer<Objective>::optimizeActiveNetwo
     oldCodelength = m_objective.getCodelength();
   } while (coreLoopCount != loopLimit);
 
+  m_useActiveSet = false;
   return numEffectiveLoops;
 }
 
@@ -509,188 +721,272 @@ INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestMod
   // Map with module links, persistent across sweeps
   if (m_deltaFlow.capacity() < numNodes)
     m_deltaFlow = VectorMap<DeltaFlowDataType>(numNodes);
-  auto& deltaFlow = m_deltaFlow;
 
-  for (unsigned int i = 0; i < numNodes; ++i) {
-    InfoNode& current = *network[nodeEnumeration[i]];
+  for (unsigned int i = 0; i < numNodes; ++i)
+    numMoved += tryMoveNodeIntoBestModule(nodeEnumeration[i], numRandomMoves);
 
-    if (!current.dirty)
-      continue;
+  return numMoved;
+}
 
-    // If other nodes have moved here, don't move away on first loop
-    if (m_moduleMembers[current.index] > 1 && m_infomap->isFirstLoop() && m_infomap->tuneIterationLimit != 1)
-      continue;
+/**
+ * Move a node into the module that reduces the codelength the most, if any,
+ * and mark its neighbours dirty. A node left alone in the old module with a
+ * single link to the moved node follows it.
+ *
+ * @return The number of nodes moved.
+ */
+template <typename Objective>
+INFOMAP_HOT inline unsigned int InfomapOptimizer<Objective>::tryMoveNodeIntoBestModule(unsigned int nodeIndex, unsigned int numRandomMoves)
+{
+  auto& network = m_infomap->activeNetwork();
+  InfoNode& current = *network[nodeIndex];
+  if (!current.dirty)
+    return 0;
 
-    deltaFlow.startRound();
+  // If other nodes have moved here, don't move away on first loop
+  if (m_moduleMembers[current.index] > 1 && m_infomap->isFirstLoop() && m_infomap->tuneIterationLimit != 1)
+    return 0;
 
-    // For all outlinks
-    for (auto& e : current.outEdges()) {
-      auto& edge = *e;
-      InfoNode* neighbour = edge.target;
-      deltaFlow.add(neighbour->index, DeltaFlowDataType(neighbour->index, edge.data.flow, 0.0));
-    }
-    // For all inlinks
-    for (auto& e : current.inEdges()) {
-      auto& edge = *e;
-      InfoNode* neighbour = edge.source;
-      deltaFlow.add(neighbour->index, DeltaFlowDataType(neighbour->index, 0.0, edge.data.flow));
-    }
+  auto& nodeEnumeration = m_nodeEnumeration;
+  unsigned int numNodes = nodeEnumeration.size();
+  auto& deltaFlow = m_deltaFlow;
+  deltaFlow.startRound();
 
-    // For random moves
-    if (current.degree() <= m_infomap->maxDegreeForRandomMoves) {
-      for (unsigned int j = 0; j < numRandomMoves; ++j) {
-        unsigned int randIndex = m_infomap->m_rand.randInt(0, numNodes - 1);
-        InfoNode& neighbour = *network[nodeEnumeration[randIndex]];
-        deltaFlow.add(neighbour.index, DeltaFlowDataType(neighbour.index, 0, 0));
-      }
+  // For all outlinks
+  for (std::size_t k = m_outLinkOffsets[nodeIndex]; k < m_outLinkOffsets[nodeIndex + 1]; ++k) {
+    unsigned int neighbourModule = m_nodeModule[m_outNeighbours[k]];
+    deltaFlow.add(neighbourModule, DeltaFlowDataType(neighbourModule, m_outFlows[k], 0.0));
+  }
+  // For all inlinks
+  for (std::size_t k = m_inLinkOffsets[nodeIndex]; k < m_inLinkOffsets[nodeIndex + 1]; ++k) {
+    unsigned int neighbourModule = m_nodeModule[m_inNeighbours[k]];
+    deltaFlow.add(neighbourModule, DeltaFlowDataType(neighbourModule, 0.0, m_inFlows[k]));
+  }
+
+  // For random moves
+  if (current.degree() <= m_infomap->maxDegreeForRandomMoves) {
+    for (unsigned int j = 0; j < numRandomMoves; ++j) {
+      unsigned int randIndex = m_infomap->m_rand.randInt(0, numNodes - 1);
+      unsigned int neighbourModule = m_nodeModule[nodeEnumeration[randIndex]];
+      deltaFlow.add(neighbourModule, DeltaFlowDataType(neighbourModule, 0, 0));
     }
+  }
 
-    // For not moving
-    deltaFlow.add(current.index, DeltaFlowDataType(current.index, 0.0, 0.0));
-    DeltaFlowDataType& oldModuleDelta = deltaFlow[current.index];
-    oldModuleDelta.module = current.index; // Make sure index is correct if created new
+  // For not moving
+  deltaFlow.add(current.index, DeltaFlowDataType(current.index, 0.0, 0.0));
+  DeltaFlowDataType& oldModuleDelta = deltaFlow[current.index];
+  oldModuleDelta.module = current.index; // Make sure index is correct if created new
 
-    // Option to move to empty module (if node not already alone)
-    if (m_moduleMembers[current.index] > 1 && !m_emptyModules.empty()) {
-      deltaFlow.add(m_emptyModules.back(), DeltaFlowDataType(m_emptyModules.back(), 0.0, 0.0));
-    }
+  // Option to move to empty module (if node not already alone)
+  if (m_moduleMembers[current.index] > 1 && !m_emptyModules.empty()) {
+    deltaFlow.add(m_emptyModules.back(), DeltaFlowDataType(m_emptyModules.back(), 0.0, 0.0));
+  }
 
-    // For memory networks
-    m_objective.addMemoryContributions(current, oldModuleDelta, deltaFlow);
+  // For memory networks
+  m_objective.addMemoryContributions(current, oldModuleDelta, deltaFlow);
 
-    // For recorded teleportation
-    m_objective.addTeleportationFlow(current, m_moduleFlowData, deltaFlow);
-
-    auto& moduleDeltaEnterExit = deltaFlow.values();
-    unsigned int numModuleLinks = deltaFlow.size();
-
-    // Randomize link order for optimized search
-    auto& moduleEnumeration = m_moduleEnumeration;
-    moduleEnumeration.resize(numModuleLinks);
-    m_infomap->m_rand.getRandomizedIndexVector(moduleEnumeration);
-
-    DeltaFlowDataType bestDeltaModule(oldModuleDelta);
-    double bestDeltaCodelength = 0.0;
-    DeltaFlowDataType strongestConnectedModule(oldModuleDelta);
-    double deltaCodelengthOnStrongestConnectedModule = 0.0;
-
-    // Old-module plogp terms are constant across every candidate of this node:
-    // hoist them out of the per-candidate delta (see MapEquation::hoistOldSide).
-    const OldSideTerms oldSide = m_objective.hoistOldSide(current, oldModuleDelta, m_moduleFlowData);
-
-    // Find the move that minimizes the description length
-    for (unsigned int k = 0; k < numModuleLinks; ++k) {
-      auto j = moduleEnumeration[k];
-      unsigned int otherModule = moduleDeltaEnterExit[j].module;
-      if (otherModule != current.index) {
-        double deltaCodelength = m_objective.getDeltaCodelengthOnMovingNodeHoisted(current,
-                                                                                   oldModuleDelta,
-                                                                                   oldSide,
-                                                                                   moduleDeltaEnterExit[j],
-                                                                                   m_moduleFlowData,
-                                                                                   m_moduleMembers);
-
-        if (deltaCodelength < bestDeltaCodelength - m_infomap->minimumSingleNodeCodelengthImprovement) {
-          bestDeltaModule = moduleDeltaEnterExit[j];
-          bestDeltaCodelength = deltaCodelength;
-        }
+  // For recorded teleportation
+  m_objective.addTeleportationFlow(current, m_moduleFlowData, deltaFlow);
+
+  auto& moduleDeltaEnterExit = deltaFlow.values();
+  unsigned int numModuleLinks = deltaFlow.size();
+
+  // Randomize link order for optimized search
+  auto& moduleEnumeration = m_moduleEnumeration;
+  moduleEnumeration.resize(numModuleLinks);
+  m_infomap->m_rand.getRandomizedIndexVector(moduleEnumeration);
+
+  DeltaFlowDataType bestDeltaModule(oldModuleDelta);
+  double bestDeltaCodelength = 0.0;
+  DeltaFlowDataType strongestConnectedModule(oldModuleDelta);
+  double deltaCodelengthOnStrongestConnectedModule = 0.0;
+
+  // Old-module plogp terms are constant across every candidate of this node:
+  // hoist them out of the per-candidate delta (see MapEquation::hoistOldSide),
+  // then score all candidates in one batch.
+  const OldSideTerms oldSide = m_objective.hoistOldSide(current, oldModuleDelta, m_moduleFlowData);
+  m_objective.getDeltaCodelengthOnMovingNodeBatch(current, oldModuleDelta, oldSide, moduleDeltaEnterExit.data(), numModuleLinks, m_moduleFlowData, m_moduleMembers, m_deltaBatch);
+  const auto& deltaCodelengths = m_deltaBatch.deltas;
+
+  // Find the move that minimizes the description length
+  for (unsigned int k = 0; k < numModuleLinks; ++k) {
+    auto j = moduleEnumeration[k];
+    unsigned int otherModule = moduleDeltaEnterExit[j].module;
+    if (otherModule != current.index) {
+      double deltaCodelength = deltaCodelengths[j];
+
+      if (deltaCodelength < bestDeltaCodelength - m_infomap->minimumSingleNodeCodelengthImprovement) {
+        bestDeltaModule = moduleDeltaEnterExit[j];
+        bestDeltaCodelength = deltaCodelength;
+      }
 
-        // Save strongest connected module to prefer if codelength improvement equal
-        if (moduleDeltaEnterExit[j].deltaExit > strongestConnectedModule.deltaExit) {
-          strongestConnectedModule = moduleDeltaEnterExit[j];
-          deltaCodelengthOnStrongestConnectedModule = deltaCodelength;
-        }
+      // Save strongest connected module to prefer if codelength improvement equal
+      if (moduleDeltaEnterExit[j].deltaExit > strongestConnectedModule.deltaExit) {
+        strongestConnectedModule = moduleDeltaEnterExit[j];
+        deltaCodelengthOnStrongestConnectedModule = deltaCodelength;
       }
     }
+  }
 
-    // Prefer strongest connected module if equal delta codelength
-    if (strongestConnectedModule.module != bestDeltaModule.module && deltaCodelengthOnStrongestConnectedModule <= bestDeltaCodelength + m_infomap->minimumSingleNodeCodelengthImprovement) {
-      bestDeltaModule = strongestConnectedModule;
-    }
+  // Prefer strongest connected module if equal delta codelength
+  if (strongestConnectedModule.module != bestDeltaModule.module && deltaCodelengthOnStrongestConnectedModule <= bestDeltaCodelength + m_infomap->minimumSingleNodeCodelengthImprovement) {
+    bestDeltaModule = strongestConnectedModule;
+  }
 
-    // Make best possible move
-    if (bestDeltaModule.module != current.index) {
-      unsigned int bestModuleIndex = bestDeltaModule.module;
-      // Update empty module vector
-      if (m_moduleMembers[bestModuleIndex] == 0) {
-        m_emptyModules.pop_back();
-      }
-      if (m_moduleMembers[current.index] == 1) {
-        m_emptyModules.push_back(current.index);
-      }
+  // Make best possible move
+  if (bestDeltaModule.module != current.index) {
+    unsigned int bestModuleIndex = bestDeltaModule.module;
+    // Update empty module vector
+    if (m_moduleMembers[bestModuleIndex] == 0) {
+      m_emptyModules.pop_back();
+    }
+    if (m_moduleMembers[current.index] == 1) {
+      m_emptyModules.push_back(current.index);
+    }
 
-      m_objective.updateCodelengthOnMovingNode(current, oldModuleDelta, bestDeltaModule, m_moduleFlowData, m_moduleMembers);
+    m_objective.updateCodelengthOnMovingNode(current, oldModuleDelta, bestDeltaModule, m_moduleFlowData, m_moduleMembers);
 
-      m_moduleMembers[current.index] -= 1;
-      m_moduleMembers[bestModuleIndex] += 1;
+    m_moduleMembers[current.index] -= 1;
+    m_moduleMembers[bestModuleIndex] += 1;
 
-      unsigned int oldModuleIndex = current.index;
-      current.index = bestModuleIndex;
+    unsigned int oldModuleIndex = current.index;
+    current.index = bestModuleIndex;
+    m_nodeModule[nodeIndex] = bestModuleIndex;
 
-      ++numMoved;
+    unsigned int numMoved = 1;
 
-      InfoNode* nodeInOldModule = &current;
-      unsigned int numLinkedNodesInOldModule = 0;
-      // Mark neighbours as dirty
-      for (auto& e : current.outEdges()) {
-        e->target->dirty = true;
-        if (e->target->index == oldModuleIndex) {
-          nodeInOldModule = e->target;
-          ++numLinkedNodesInOldModule;
-        }
+    unsigned int nodeInOldModule = nodeIndex;
+    unsigned int numLinkedNodesInOldModule = 0;
+    // Mark neighbours as dirty
+    for (std::size_t k = m_outLinkOffsets[nodeIndex]; k < m_outLinkOffsets[nodeIndex + 1]; ++k) {
+      const unsigned int neighbourIndex = m_outNeighbours[k];
+      markDirty(neighbourIndex);
+      if (m_nodeModule[neighbourIndex] == oldModuleIndex) {
+        nodeInOldModule = neighbourIndex;
+        ++numLinkedNodesInOldModule;
       }
-      for (auto& e : current.inEdges()) {
-        e->source->dirty = true;
-        if (e->source->index == oldModuleIndex) {
-          nodeInOldModule = e->source;
-          ++numLinkedNodesInOldModule;
-        }
+    }
+    for (std::size_t k = m_inLinkOffsets[nodeIndex]; k < m_inLinkOffsets[nodeIndex + 1]; ++k) {
+      const unsigned int neighbourIndex = m_inNeighbours[k];
+      markDirty(neighbourIndex);
+      if (m_nodeModule[neighbourIndex] == oldModuleIndex) {
+        nodeInOldModule = neighbourIndex;
+        ++numLinkedNodesInOldModule;
       }
+    }
 
-      // Move single connected nodes to same module
-      if (numLinkedNodesInOldModule == 1 && m_moduleMembers[oldModuleIndex] == 1) {
-        moveNodeToPredefinedModule(*nodeInOldModule, bestModuleIndex);
-        ++numMoved;
-        // Mark neighbours as dirty
-        if (nodeInOldModule->degree() > 1) {
-          for (auto& e : nodeInOldModule->outEdges())
-            e->target->dirty = true;
-          for (auto& e : nodeInOldModule->inEdges())
-            e->source->dirty = true;
-        }
-      }
-    } else {
-      current.dirty = false;
+    // Move single connected nodes to same module
+    if (numLinkedNodesInOldModule == 1 && m_moduleMembers[oldModuleIndex] == 1) {
+      moveNodeToPredefinedModule(nodeInOldModule, bestModuleIndex);
+      ++numMoved;
+      // Mark neighbours as dirty
+      if (network[nodeInOldModule]->degree() > 1)
+        markNeighboursDirty(nodeInOldModule);
     }
+    return numMoved;
   }
 
-  return numMoved;
+  current.dirty = false;
+  return 0;
+}
+
+template <typename Objective>
+inline void InfomapOptimizer<Objective>::markDirty(unsigned int nodeIndex)
+{
+  InfoNode& node = *m_infomap->activeNetwork()[nodeIndex];
+  if (node.dirty)
+    return;
+  node.dirty = true;
+  if (m_useActiveSet)
+    m_nextActivePositions.push_back(nodeIndex);
+}
+
+template <typename Objective>
+inline void InfomapOptimizer<Objective>::markNeighboursDirty(unsigned int nodeIndex)
+{
+  for (std::size_t k = m_outLinkOffsets[nodeIndex]; k < m_outLinkOffsets[nodeIndex + 1]; ++k)
+    markDirty(m_outNeighbours[k]);
+  for (std::size_t k = m_inLinkOffsets[nodeIndex]; k < m_inLinkOffsets[nodeIndex + 1]; ++k)
+    markDirty(m_inNeighbours[k]);
 }
 
 /**
- * Minimize the codelength by trying to move each node into best module, in parallel.
+ * Minimize the codelength by trying to move each node of the active set into
+ * its best module, in random order.
  *
- * For each node:
- * 1. Calculate the change in codelength for a move to each of its neighbouring modules or to an empty module
- * 2. Move to the one that reduces the codelength the most, if any.
+ * Unlike tryMoveEachNodeIntoBestModule, nodes dirtied during the sweep wait
+ * for the next one, which visits only the active set instead of scanning the
+ * whole network for dirty nodes.
  *
  * @return The number of nodes moved.
  */
 template <typename Objective>
-INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestModuleInParallel()
+INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachActiveNodeIntoBestModule()
 {
-  // Get random enumeration of nodes
   auto& network = m_infomap->activeNetwork();
-  auto& nodeEnumeration = m_nodeEnumeration;
-  nodeEnumeration.resize(network.size());
-  m_infomap->m_rand.getRandomizedIndexVector(nodeEnumeration);
+  auto& activePositions = m_activePositions;
+  m_infomap->m_rand.shuffle(activePositions);
+  m_nextActivePositions.clear();
 
-  unsigned int numNodes = nodeEnumeration.size();
+  const auto numNodes = static_cast<unsigned int>(m_nodeEnumeration.size());
+  unsigned int numMoved = 0;
   unsigned int numRandomMoves = std::min(m_infomap->numRandomMoves, numNodes);
-  const unsigned int parallelMoveSweep = ++m_innerParallelMoveSweep;
 
-  // Random-move targets in a flat array indexed by enumeration position, drawn
-  // serially up front so the parallel sweep never touches the shared RNG.
+  for (unsigned int nodeIndex : activePositions) {
+    numMoved += tryMoveNodeIntoBestModule(nodeIndex, numRandomMoves);
+    // Moved or skipped nodes stay dirty; nodes marked dirty before their turn
+    // come back here rather than through markDirty.
+    if (network[nodeIndex]->dirty)
+      m_nextActivePositions.push_back(nodeIndex);
+  }
+
+  Log(3).print("Active set: swept {} of {} nodes, moved: {}\n", activePositions.size(), numNodes, numMoved);
+  activePositions.swap(m_nextActivePositions);
+  return numMoved;
+}
+
+/**
+ * Seed the active set with the dirty nodes of the active network.
+ *
+ * The serial sweep draws its random-move targets through m_nodeEnumeration,
+ * which here is the identity.
+ */
+template <typename Objective>
+inline void InfomapOptimizer<Objective>::initActiveSet(bool parallel)
+{
+  auto& network = m_infomap->activeNetwork();
+  const auto numNodes = static_cast<unsigned int>(network.size());
+  m_activePositions.clear();
+  for (unsigned int i = 0; i < numNodes; ++i) {
+    if (network[i]->dirty)
+      m_activePositions.push_back(i);
+  }
+  if (parallel)
+    return;
+
+  if (m_deltaFlow.capacity() < numNodes)
+    m_deltaFlow = VectorMap<DeltaFlowDataType>(numNodes);
+  m_nodeEnumeration.resize(numNodes);
+  std::iota(m_nodeEnumeration.begin(), m_nodeEnumeration.end(), 0u);
+}
+
+/**
+ * Draw the random-move targets of a parallel sweep and size its buffers.
+ *
+ * Random-move targets go in a flat array indexed by enumeration position, drawn
+ * serially up front so the parallel sweep never touches the shared RNG.
+ *
+ * @return Whether the sweep tries random moves.
+ */
+template <typename Objective>
+inline bool InfomapOptimizer<Objective>::prepareParallelMoveSweep()
+{
+  auto& network = m_infomap->activeNetwork();
+  const auto& nodeEnumeration = m_nodeEnumeration;
+  unsigned int numNodes = nodeEnumeration.size();
+  const auto networkSize = static_cast<unsigned int>(network.size());
+  unsigned int numRandomMoves = std::min(m_infomap->numRandomMoves, networkSize);
+
   const bool useRandomMoves = numRandomMoves > 0;
   if (useRandomMoves) {
     m_randomMoveTargets.clear();
@@ -703,172 +999,247 @@ INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestMod
           && current.degree() <= m_infomap->maxDegreeForRandomMoves;
       if (wantRandomMoves) {
         for (unsigned int j = 0; j < numRandomMoves; ++j) {
-          unsigned int randIndex = m_infomap->m_rand.randInt(0, numNodes - 1);
-          m_randomMoveTargets.push_back(nodeEnumeration[randIndex]);
+          // The active set is only part of the network, so draw from the whole.
+          unsigned int randIndex = m_infomap->m_rand.randInt(0, networkSize - 1);
+          m_randomMoveTargets.push_back(m_useActiveSet ? randIndex : nodeEnumeration[randIndex]);
         }
       }
       m_randomMoveTargetOffsets[i + 1] = static_cast<unsigned int>(m_randomMoveTargets.size());
     }
   }
 
-  auto& proposals = m_moveProposals;
-  proposals.assign(numNodes, ParallelMoveProposal());
+  if (m_useActiveSet) {
+    // Only the swept nodes' proposals are read, so only those are reset.
+    m_moveProposals.resize(networkSize);
+    for (unsigned int nodeIndex : nodeEnumeration)
+      m_moveProposals[nodeIndex] = ParallelMoveProposal();
+  } else {
+    m_moveProposals.assign(numNodes, ParallelMoveProposal());
+  }
 
 #ifdef _OPENMP
   const auto numThreads = static_cast<unsigned int>(std::max(1, omp_get_max_threads()));
 #else
   const unsigned int numThreads = 1;
 #endif
-  if (m_threadDeltaFlow.size() < numThreads || m_threadDeltaFlow.front().capacity() < numNodes) {
+  if (m_threadDeltaFlow.size() < numThreads || m_threadDeltaFlow.front().capacity() < networkSize) {
     const unsigned int capacity = m_threadDeltaFlow.empty()
-        ? numNodes
-        : std::max(numNodes, m_threadDeltaFlow.front().capacity());
+        ? networkSize
+        : std::max(networkSize, m_threadDeltaFlow.front().capacity());
     m_threadDeltaFlow.assign(numThreads, VectorMap<DeltaFlowDataType>(capacity));
     m_threadModuleEnumeration.resize(numThreads);
+    m_threadDeltaBatch.resize(numThreads);
   }
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-  {
-#ifdef _OPENMP
-    const auto threadNum = static_cast<unsigned int>(omp_get_thread_num());
-#else
-    const unsigned int threadNum = 0;
-#endif
-    auto& deltaFlow = m_threadDeltaFlow[threadNum];
-    auto& moduleEnumeration = m_threadModuleEnumeration[threadNum];
+  return useRandomMoves;
+}
 
-    // Chunked dynamic scheduling: load varies per node (dirty nodes cluster),
-    // but chunk size 1 costs one scheduler round-trip per iteration.
-#ifdef _OPENMP
-#pragma omp for schedule(dynamic, 512)
-#endif
-    for (unsigned int i = 0; i < numNodes; ++i) {
-      // Once cancelled, drain the sweep without throwing (no exception may leave
-      // this OpenMP region); the outer loop throws at its next checkpoint (#412).
-      if (m_infomap->interruptRequested())
-        continue;
-      deltaFlow.startRound();
+/**
+ * Find the best move of the node at enumeration position i without changing
+ * any shared state, and record it in m_moveProposals.
+ *
+ * Reads the module flow data and members read-only, so any number of nodes can
+ * be proposed concurrently, each thread with its own deltaFlow,
+ * moduleEnumeration and deltaBatch. Under --deterministic the module order is
+ * drawn from the caller's block stream, otherwise from a stream of its own per
+ * node and sweep.
+ */
+template <typename Objective>
+INFOMAP_HOT inline void InfomapOptimizer<Objective>::proposeMove(unsigned int i,
+                                                                 bool useRandomMoves,
+                                                                 unsigned int parallelMoveSweep,
+                                                                 VectorMap<DeltaFlowDataType>& deltaFlow,
+                                                                 std::vector<unsigned int>& moduleEnumeration,
+                                                                 DeltaBatchScratch& deltaBatch,
+                                                                 Random& blockRand)
+{
+  auto& network = m_infomap->activeNetwork();
+  const auto& nodeEnumeration = m_nodeEnumeration;
+  auto& proposals = m_moveProposals;
+  const bool deterministic = m_infomap->deterministic;
+  const auto seed = static_cast<unsigned int>(m_infomap->seedToRandomNumberGenerator);
 
-      // Pick nodes in random order
-      unsigned int nodeIndex = nodeEnumeration[i];
-      InfoNode& current = *network[nodeIndex];
+  // Once cancelled, drain the sweep without throwing (no exception may leave
+  // the OpenMP region); the outer loop throws at its next checkpoint (#412).
+  if (m_infomap->interruptRequested())
+    return;
+  deltaFlow.startRound();
 
-      if (!current.dirty)
-        continue;
+  // Pick nodes in random order
+  unsigned int nodeIndex = nodeEnumeration[i];
+  InfoNode& current = *network[nodeIndex];
 
-      // If other nodes have moved here, don't move away on first loop
-      if (m_moduleMembers[current.index] > 1 && m_infomap->isFirstLoop() && m_infomap->tuneIterationLimit != 1)
-        continue;
+  if (!current.dirty)
+    return;
 
-      // If no links connecting this node with other nodes, it won't move into others,
-      // and others won't move into this. TODO: Always best leave it alone?
-      // For memory networks, don't skip try move to same physical node!
+  // If other nodes have moved here, don't move away on first loop
+  if (m_moduleMembers[current.index] > 1 && m_infomap->isFirstLoop() && m_infomap->tuneIterationLimit != 1)
+    return;
 
-      // For all outlinks
-      for (auto& e : current.outEdges()) {
-        auto& edge = *e;
-        InfoNode* neighbour = edge.target;
-        deltaFlow.add(neighbour->index, DeltaFlowDataType(neighbour->index, edge.data.flow, 0.0));
-      }
-      // For all inlinks
-      for (auto& e : current.inEdges()) {
-        auto& edge = *e;
-        InfoNode* neighbour = edge.source;
-        deltaFlow.add(neighbour->index, DeltaFlowDataType(neighbour->index, 0.0, edge.data.flow));
-      }
+  // If no links connecting this node with other nodes, it won't move into others,
+  // and others won't move into this. TODO: Always best leave it alone?
+  // For memory networks, don't skip try move to same physical node!
 
-      // For random moves
-      if (useRandomMoves) {
-        for (unsigned int t = m_randomMoveTargetOffsets[i]; t < m_randomMoveTargetOffsets[i + 1]; ++t) {
-          InfoNode& neighbour = *network[m_randomMoveTargets[t]];
-          deltaFlow.add(neighbour.index, DeltaFlowDataType(neighbour.index, 0.0, 0.0));
-        }
-      }
+  // For all outlinks
+  for (std::size_t k = m_outLinkOffsets[nodeIndex]; k < m_outLinkOffsets[nodeIndex + 1]; ++k) {
+    unsigned int neighbourModule = m_nodeModule[m_outNeighbours[k]];
+    deltaFlow.add(neighbourModule, DeltaFlowDataType(neighbourModule, m_outFlows[k], 0.0));
+  }
+  // For all inlinks
+  for (std::size_t k = m_inLinkOffsets[nodeIndex]; k < m_inLinkOffsets[nodeIndex + 1]; ++k) {
+    unsigned int neighbourModule = m_nodeModule[m_inNeighbours[k]];
+    deltaFlow.add(neighbourModule, DeltaFlowDataType(neighbourModule, 0.0, m_inFlows[k]));
+  }
 
-      // For not moving
-      deltaFlow.add(current.index, DeltaFlowDataType(current.index, 0.0, 0.0));
-      DeltaFlowDataType& oldModuleDelta = deltaFlow[current.index];
-      oldModuleDelta.module = current.index; // Make sure index is correct if created new
+  // For random moves
+  if (useRandomMoves) {
+    for (unsigned int t = m_randomMoveTargetOffsets[i]; t < m_randomMoveTargetOffsets[i + 1]; ++t) {
+      unsigned int neighbourModule = m_nodeModule[m_randomMoveTargets[t]];
+      deltaFlow.add(neighbourModule, DeltaFlowDataType(neighbourModule, 0.0, 0.0));
+    }
+  }
 
-      // Option to move to empty module (if node not already alone)
-      if (m_moduleMembers[current.index] > 1 && !m_emptyModules.empty()) {
-        deltaFlow.add(m_emptyModules.back(), DeltaFlowDataType(m_emptyModules.back(), 0.0, 0.0));
-      }
+  // For not moving
+  deltaFlow.add(current.index, DeltaFlowDataType(current.index, 0.0, 0.0));
+  DeltaFlowDataType& oldModuleDelta = deltaFlow[current.index];
+  oldModuleDelta.module = current.index; // Make sure index is correct if created new
 
-      // For memory networks
-      m_objective.addMemoryContributions(current, oldModuleDelta, deltaFlow);
-
-      // For recorded teleportation
-      m_objective.addTeleportationFlow(current, m_moduleFlowData, deltaFlow);
-
-      auto& moduleDeltaEnterExit = deltaFlow.values();
-      unsigned int numModuleLinks = deltaFlow.size();
-
-      // Randomize link order for optimized search without sharing m_rand across threads.
-      moduleEnumeration.resize(numModuleLinks);
-      Random moduleRand(static_cast<unsigned int>(m_infomap->seedToRandomNumberGenerator)
-                        + 0x9e3779b9u * (nodeIndex + 1u)
-                        + 0x85ebca6bu * parallelMoveSweep);
-      moduleRand.getRandomizedIndexVector(moduleEnumeration);
-
-      DeltaFlowDataType bestDeltaModule(oldModuleDelta);
-      double bestDeltaCodelength = 0.0;
-      DeltaFlowDataType strongestConnectedModule(oldModuleDelta);
-      double deltaCodelengthOnStrongestConnectedModule = 0.0;
-
-      // Old-module plogp terms are constant across every candidate of this node
-      // (per-thread stack local; reads m_moduleFlowData read-only). See
-      // MapEquation::hoistOldSide.
-      const OldSideTerms oldSide = m_objective.hoistOldSide(current, oldModuleDelta, m_moduleFlowData);
-
-      // Find the move that minimizes the description length
-      for (unsigned int k = 0; k < numModuleLinks; ++k) {
-        auto j = moduleEnumeration[k];
-        unsigned int otherModule = moduleDeltaEnterExit[j].module;
-        if (otherModule != current.index) {
-          double deltaCodelength = m_objective.getDeltaCodelengthOnMovingNodeHoisted(current,
-                                                                                     oldModuleDelta,
-                                                                                     oldSide,
-                                                                                     moduleDeltaEnterExit[j],
-                                                                                     m_moduleFlowData,
-                                                                                     m_moduleMembers);
-
-          if (deltaCodelength < bestDeltaCodelength - m_infomap->minimumSingleNodeCodelengthImprovement) {
-            bestDeltaModule = moduleDeltaEnterExit[j];
-            bestDeltaCodelength = deltaCodelength;
-          }
-
-          // Save strongest connected module to prefer if codelength improvement equal
-          if (moduleDeltaEnterExit[j].deltaExit > strongestConnectedModule.deltaExit) {
-            strongestConnectedModule = moduleDeltaEnterExit[j];
-            deltaCodelengthOnStrongestConnectedModule = deltaCodelength;
-          }
-        }
-      }
+  // Option to move to empty module (if node not already alone)
+  if (m_moduleMembers[current.index] > 1 && !m_emptyModules.empty()) {
+    deltaFlow.add(m_emptyModules.back(), DeltaFlowDataType(m_emptyModules.back(), 0.0, 0.0));
+  }
 
-      // Prefer strongest connected module if equal delta codelength
-      if (strongestConnectedModule.module != bestDeltaModule.module && deltaCodelengthOnStrongestConnectedModule <= bestDeltaCodelength + m_infomap->minimumSingleNodeCodelengthImprovement) {
-        bestDeltaModule = strongestConnectedModule;
+  // For memory networks
+  m_objective.addMemoryContributions(current, oldModuleDelta, deltaFlow);
+
+  // For recorded teleportation
+  m_objective.addTeleportationFlow(current, m_moduleFlowData, deltaFlow);
+
+  auto& moduleDeltaEnterExit = deltaFlow.values();
+  unsigned int numModuleLinks = deltaFlow.size();
+
+  // Randomize link order for optimized search without sharing m_rand across threads.
+  moduleEnumeration.resize(numModuleLinks);
+  if (deterministic) {
+    blockRand.getRandomizedIndexVector(moduleEnumeration);
+  } else {
+    Random moduleRand(seed + 0x9e3779b9u * (nodeIndex + 1u) + 0x85ebca6bu * parallelMoveSweep);
+    moduleRand.getRandomizedIndexVector(moduleEnumeration);
+  }
+
+  DeltaFlowDataType bestDeltaModule(oldModuleDelta);
+  double bestDeltaCodelength = 0.0;
+  DeltaFlowDataType strongestConnectedModule(oldModuleDelta);
+  double deltaCodelengthOnStrongestConnectedModule = 0.0;
+
+  // Old-module plogp terms are constant across every candidate of this node
+  // (per-thread stack local; reads m_moduleFlowData read-only). See
+  // MapEquation::hoistOldSide.
+  const OldSideTerms oldSide = m_objective.hoistOldSide(current, oldModuleDelta, m_moduleFlowData);
+  m_objective.getDeltaCodelengthOnMovingNodeBatch(current, oldModuleDelta, oldSide, moduleDeltaEnterExit.data(), numModuleLinks, m_moduleFlowData, m_moduleMembers, deltaBatch);
+  const auto& deltaCodelengths = deltaBatch.deltas;
+
+  // Find the move that minimizes the description length
+  for (unsigned int k = 0; k < numModuleLinks; ++k) {
+    auto j = moduleEnumeration[k];
+    unsigned int otherModule = moduleDeltaEnterExit[j].module;
+    if (otherModule != current.index) {
+      double deltaCodelength = deltaCodelengths[j];
+
+      if (deltaCodelength < bestDeltaCodelength - m_infomap->minimumSingleNodeCodelengthImprovement) {
+        bestDeltaModule = moduleDeltaEnterExit[j];
+        bestDeltaCodelength = deltaCodelength;
       }
 
-      // Make best possible move
-      if (bestDeltaModule.module == current.index) {
-        auto& proposal = proposals[nodeIndex];
-        proposal.clearDirty = true;
-        proposal.nodeIndex = nodeIndex;
-        continue;
+      // Save strongest connected module to prefer if codelength improvement equal
+      if (moduleDeltaEnterExit[j].deltaExit > strongestConnectedModule.deltaExit) {
+        strongestConnectedModule = moduleDeltaEnterExit[j];
+        deltaCodelengthOnStrongestConnectedModule = deltaCodelength;
       }
+    }
+  }
 
-      auto& proposal = proposals[nodeIndex];
-      proposal.valid = true;
-      proposal.nodeIndex = nodeIndex;
-      proposal.oldModule = current.index;
-      proposal.newModule = bestDeltaModule.module;
-      proposal.targetWasEmpty = m_moduleMembers[bestDeltaModule.module] == 0;
-      proposal.oldDelta = oldModuleDelta;
-      proposal.newDelta = bestDeltaModule;
+  // Prefer strongest connected module if equal delta codelength
+  if (strongestConnectedModule.module != bestDeltaModule.module && deltaCodelengthOnStrongestConnectedModule <= bestDeltaCodelength + m_infomap->minimumSingleNodeCodelengthImprovement) {
+    bestDeltaModule = strongestConnectedModule;
+  }
+
+  // Make best possible move
+  if (bestDeltaModule.module == current.index) {
+    auto& proposal = proposals[nodeIndex];
+    proposal.clearDirty = true;
+    proposal.nodeIndex = nodeIndex;
+    return;
+  }
+
+  auto& proposal = proposals[nodeIndex];
+  proposal.valid = true;
+  proposal.nodeIndex = nodeIndex;
+  proposal.oldModule = current.index;
+  proposal.newModule = bestDeltaModule.module;
+  proposal.targetWasEmpty = m_moduleMembers[bestDeltaModule.module] == 0;
+  proposal.oldDelta = oldModuleDelta;
+  proposal.newDelta = bestDeltaModule;
+}
+
+/**
+ * Minimize the codelength by trying to move each node into best module, in parallel.
+ *
+ * For each node:
+ * 1. Calculate the change in codelength for a move to each of its neighbouring modules or to an empty module
+ * 2. Move to the one that reduces the codelength the most, if any.
+ *
+ * @return The number of nodes moved.
+ */
+template <typename Objective>
+INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestModuleInParallel()
+{
+  // Get random enumeration of nodes, or of the active set
+  auto& network = m_infomap->activeNetwork();
+  auto& nodeEnumeration = m_nodeEnumeration;
+  if (m_useActiveSet) {
+    nodeEnumeration.swap(m_activePositions);
+    m_infomap->m_rand.shuffle(nodeEnumeration);
+  } else {
+    nodeEnumeration.resize(network.size());
+    m_infomap->m_rand.getRandomizedIndexVector(nodeEnumeration);
+  }
+
+  unsigned int numNodes = nodeEnumeration.size();
+  const unsigned int parallelMoveSweep = ++m_innerParallelMoveSweep;
+  const bool useRandomMoves = prepareParallelMoveSweep();
+  auto& proposals = m_moveProposals;
+
+  const auto seed = static_cast<unsigned int>(m_infomap->seedToRandomNumberGenerator);
+  const unsigned int numBlocks = (numNodes + innerParallelMoveBlockSize - 1) / innerParallelMoveBlockSize;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+#ifdef _OPENMP
+    const auto threadNum = static_cast<unsigned int>(omp_get_thread_num());
+#else
+    const unsigned int threadNum = 0;
+#endif
+    auto& deltaFlow = m_threadDeltaFlow[threadNum];
+    auto& moduleEnumeration = m_threadModuleEnumeration[threadNum];
+    auto& deltaBatch = m_threadDeltaBatch[threadNum];
+
+    // Dynamic scheduling over fixed blocks of enumeration positions: load
+    // varies per node (dirty nodes cluster), but one scheduler round-trip per
+    // node would cost more than the imbalance.
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for (unsigned int block = 0; block < numBlocks; ++block) {
+      // Under --deterministic, one random stream per block, consumed in
+      // enumeration order within the block, so no draw depends on which thread
+      // runs the block or on how many threads there are.
+      Random blockRand(seed + 0x9e3779b9u * (block + 1u) + 0xc2b2ae35u * parallelMoveSweep);
+      const unsigned int blockEnd = std::min(numNodes, (block + 1) * innerParallelMoveBlockSize);
+      for (unsigned int i = block * innerParallelMoveBlockSize; i < blockEnd; ++i)
+        proposeMove(i, useRandomMoves, parallelMoveSweep, deltaFlow, moduleEnumeration, deltaBatch, blockRand);
     }
   }
 
@@ -881,8 +1252,8 @@ INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestMod
   unsigned int numSkippedInvalidTarget = 0;
   unsigned int numSkippedRejectedRecheck = 0;
 
-  if (m_moduleTouchedSweep.size() < numNodes)
-    m_moduleTouchedSweep.resize(numNodes, 0);
+  if (m_moduleTouchedSweep.size() < network.size())
+    m_moduleTouchedSweep.resize(network.size(), 0);
 
   for (unsigned int nodeIndex : nodeEnumeration) {
     auto& proposal = proposals[nodeIndex];
@@ -894,13 +1265,16 @@ INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestMod
     // The propose phase is read-only, so every proposal is evaluated against
     // the sweep-start snapshot. If the commit phase has not yet changed either
     // module, the proposal's deltas are still exact and the recheck (with its
-    // edge iteration and delta re-evaluation) can be skipped.
+    // edge iteration and delta re-evaluation) can be skipped. That holds for the
+    // memory terms as well: they read only the two modules' physical-node
+    // entries, which change only when a move into or out of them is committed.
     if (m_moduleTouchedSweep[proposal.oldModule] != parallelMoveSweep
         && m_moduleTouchedSweep[proposal.newModule] != parallelMoveSweep) {
       m_objective.updateCodelengthOnMovingNode(current, proposal.oldDelta, proposal.newDelta, m_moduleFlowData, m_moduleMembers);
       m_moduleMembers[proposal.oldModule] -= 1;
       m_moduleMembers[proposal.newModule] += 1;
       current.index = proposal.newModule;
+      m_nodeModule[nodeIndex] = proposal.newModule;
       m_moduleTouchedSweep[proposal.oldModule] = parallelMoveSweep;
       m_moduleTouchedSweep[proposal.newModule] = parallelMoveSweep;
       ++numFastAccepts;
@@ -925,25 +1299,26 @@ INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestMod
     DeltaFlowDataType oldModuleDelta(oldModule, 0.0, 0.0);
     DeltaFlowDataType newModuleDelta(newModule, 0.0, 0.0);
 
-    for (auto& e : current.outEdges()) {
-      auto& edge = *e;
-      unsigned int otherModule = edge.target->index;
+    for (std::size_t k = m_outLinkOffsets[nodeIndex]; k < m_outLinkOffsets[nodeIndex + 1]; ++k) {
+      unsigned int otherModule = m_nodeModule[m_outNeighbours[k]];
       if (otherModule == oldModule) {
-        oldModuleDelta.deltaExit += edge.data.flow;
+        oldModuleDelta.deltaExit += m_outFlows[k];
       } else if (otherModule == newModule) {
-        newModuleDelta.deltaExit += edge.data.flow;
+        newModuleDelta.deltaExit += m_outFlows[k];
       }
     }
-    for (auto& e : current.inEdges()) {
-      auto& edge = *e;
-      unsigned int otherModule = edge.source->index;
+    for (std::size_t k = m_inLinkOffsets[nodeIndex]; k < m_inLinkOffsets[nodeIndex + 1]; ++k) {
+      unsigned int otherModule = m_nodeModule[m_inNeighbours[k]];
       if (otherModule == oldModule) {
-        oldModuleDelta.deltaEnter += edge.data.flow;
+        oldModuleDelta.deltaEnter += m_inFlows[k];
       } else if (otherModule == newModule) {
-        newModuleDelta.deltaEnter += edge.data.flow;
+        newModuleDelta.deltaEnter += m_inFlows[k];
       }
     }
 
+    // For memory networks, against the physical-node map as committed so far
+    m_objective.addMemoryContributions(current, oldModuleDelta, newModuleDelta);
+
     // For recorded teleportation
     m_objective.addTeleportationFlow(current, m_moduleFlowData, oldModuleDelta, newModuleDelta);
 
@@ -962,6 +1337,7 @@ INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestMod
     m_moduleMembers[oldModule] -= 1;
     m_moduleMembers[newModule] += 1;
     current.index = newModule;
+    m_nodeModule[nodeIndex] = newModule;
     m_moduleTouchedSweep[oldModule] = parallelMoveSweep;
     m_moduleTouchedSweep[newModule] = parallelMoveSweep;
 
@@ -977,19 +1353,19 @@ INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestMod
                numSkippedInvalidTarget,
                numSkippedRejectedRecheck);
 
-  for (auto& proposal : proposals) {
-    if (proposal.clearDirty)
-      network[proposal.nodeIndex]->dirty = false;
+  for (unsigned int nodeIndex : nodeEnumeration) {
+    if (proposals[nodeIndex].clearDirty)
+      network[nodeIndex]->dirty = false;
   }
 
-  for (unsigned int nodeIndex : selectedProposalIndices) {
-    InfoNode& current = *network[nodeIndex];
-    for (auto& e : current.outEdges())
-      e->target->dirty = true;
-    for (auto& e : current.inEdges())
-      e->source->dirty = true;
+  if (m_useActiveSet) {
+    updateActiveSetAfterParallelSweep();
+    return numMoved;
   }
 
+  for (unsigned int nodeIndex : selectedProposalIndices)
+    markNeighboursDirty(nodeIndex);
+
   m_emptyModules.clear();
   for (unsigned int moduleIndex = 0; moduleIndex < m_moduleMembers.size(); ++moduleIndex) {
     if (m_moduleMembers[moduleIndex] == 0)
@@ -999,6 +1375,256 @@ INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestMod
   return numMoved;
 }
 
+/**
+ * Collect the next active set of the parallel sweep without a pass over the
+ * whole network: the swept nodes that stay dirty and the neighbours of the
+ * movers. The empty-module stack follows from the moves the same way.
+ */
+template <typename Objective>
+inline void InfomapOptimizer<Objective>::updateActiveSetAfterParallelSweep()
+{
+  auto& network = m_infomap->activeNetwork();
+  m_nextActivePositions.clear();
+  for (unsigned int nodeIndex : m_nodeEnumeration) {
+    if (network[nodeIndex]->dirty)
+      m_nextActivePositions.push_back(nodeIndex);
+  }
+  for (unsigned int nodeIndex : m_acceptedProposalIndices)
+    markNeighboursDirty(nodeIndex);
+  m_activePositions.swap(m_nextActivePositions);
+
+  // Every move into an empty module took the top of the stack, so only that
+  // one can have been filled; the movers' old modules are the only ones that
+  // can have been emptied.
+  if (!m_emptyModules.empty() && m_moduleMembers[m_emptyModules.back()] > 0)
+    m_emptyModules.pop_back();
+  const auto numEmptyBefore = m_emptyModules.size();
+  for (unsigned int nodeIndex : m_acceptedProposalIndices) {
+    const unsigned int oldModule = m_moveProposals[nodeIndex].oldModule;
+    if (m_moduleMembers[oldModule] == 0)
+      m_emptyModules.push_back(oldModule);
+  }
+  std::sort(m_emptyModules.begin() + numEmptyBefore, m_emptyModules.end());
+  m_emptyModules.erase(std::unique(m_emptyModules.begin() + numEmptyBefore, m_emptyModules.end()), m_emptyModules.end());
+}
+
+/**
+ * Greedy distance-1 coloring of the active network: no two linked nodes share a
+ * color. Nodes are colored in network order with the smallest color none of
+ * their neighbours has, so the coloring follows from the network alone.
+ */
+template <typename Objective>
+inline void InfomapOptimizer<Objective>::colorActiveNetwork()
+{
+  const auto numNodes = static_cast<unsigned int>(m_infomap->activeNetwork().size());
+
+  constexpr auto uncolored = std::numeric_limits<unsigned int>::max();
+  m_nodeColor.assign(numNodes, uncolored);
+  m_numColors = 0;
+  // The node that last saw each color on a neighbour, so the buffer needs no
+  // clearing between nodes.
+  std::vector<unsigned int> colorSeenBy;
+  const auto markNeighbourColor = [&](unsigned int neighbourIndex, unsigned int nodeIndex) {
+    const unsigned int color = m_nodeColor[neighbourIndex];
+    if (color != uncolored)
+      colorSeenBy[color] = nodeIndex;
+  };
+  for (unsigned int i = 0; i < numNodes; ++i) {
+    colorSeenBy.resize(m_numColors + 1, uncolored);
+    for (std::size_t k = m_outLinkOffsets[i]; k < m_outLinkOffsets[i + 1]; ++k)
+      markNeighbourColor(m_outNeighbours[k], i);
+    for (std::size_t k = m_inLinkOffsets[i]; k < m_inLinkOffsets[i + 1]; ++k)
+      markNeighbourColor(m_inNeighbours[k], i);
+    unsigned int color = 0;
+    while (colorSeenBy[color] == i)
+      ++color;
+    m_nodeColor[i] = color;
+    m_numColors = std::max(m_numColors, color + 1);
+  }
+
+  Log(3).print("Inner-parallelization coloring: {} colors for {} nodes\n", m_numColors, numNodes);
+}
+
+/**
+ * Minimize the codelength by moving the nodes of one color at a time, in parallel.
+ *
+ * Nodes of one color share no links, so the change a move makes to the enter
+ * and exit flow of its two modules does not depend on the other moves of the
+ * color. Each color is proposed against the module state the previous colors
+ * left and applied at once, updating the module flow atomically, with no
+ * per-move recheck; the codelength terms of the changed modules are then
+ * replaced in one pass.
+ *
+ * @return The number of nodes moved.
+ */
+template <typename Objective>
+INFOMAP_HOT unsigned int InfomapOptimizer<Objective>::tryMoveEachNodeIntoBestModuleByColor()
+{
+  // Get random enumeration of nodes
+  auto& network = m_infomap->activeNetwork();
+  auto& nodeEnumeration = m_nodeEnumeration;
+  nodeEnumeration.resize(network.size());
+  m_infomap->m_rand.getRandomizedIndexVector(nodeEnumeration);
+
+  unsigned int numNodes = nodeEnumeration.size();
+  const unsigned int parallelMoveSweep = ++m_innerParallelMoveSweep;
+  const bool useRandomMoves = prepareParallelMoveSweep();
+  auto& proposals = m_moveProposals;
+
+  const bool deterministic = m_infomap->deterministic;
+  const auto seed = static_cast<unsigned int>(m_infomap->seedToRandomNumberGenerator);
+
+  // Bucket the enumeration positions by color, in enumeration order within a color.
+  m_colorPositionOffsets.assign(m_numColors + 1, 0);
+  for (unsigned int nodeIndex : nodeEnumeration)
+    ++m_colorPositionOffsets[m_nodeColor[nodeIndex] + 1];
+  for (unsigned int color = 0; color < m_numColors; ++color)
+    m_colorPositionOffsets[color + 1] += m_colorPositionOffsets[color];
+  m_colorPositions.resize(numNodes);
+  {
+    std::vector<unsigned int> next(m_colorPositionOffsets.begin(), m_colorPositionOffsets.end() - 1);
+    for (unsigned int i = 0; i < numNodes; ++i)
+      m_colorPositions[next[m_nodeColor[nodeEnumeration[i]]]++] = i;
+  }
+
+  if (m_moduleChangedColor.size() < numNodes)
+    m_moduleChangedColor.resize(numNodes, 0);
+
+  auto& movedNodes = m_acceptedProposalIndices;
+  movedNodes.clear();
+  unsigned int blockOffset = 0;
+
+  for (unsigned int color = 0; color < m_numColors; ++color) {
+    const unsigned int colorBegin = m_colorPositionOffsets[color];
+    const unsigned int colorEnd = m_colorPositionOffsets[color + 1];
+    const unsigned int numBlocks = (colorEnd - colorBegin + innerParallelMoveBlockSize - 1) / innerParallelMoveBlockSize;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+      const auto threadNum = static_cast<unsigned int>(omp_get_thread_num());
+#else
+      const unsigned int threadNum = 0;
+#endif
+      auto& deltaFlow = m_threadDeltaFlow[threadNum];
+      auto& moduleEnumeration = m_threadModuleEnumeration[threadNum];
+      auto& deltaBatch = m_threadDeltaBatch[threadNum];
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for (unsigned int block = 0; block < numBlocks; ++block) {
+        // Numbered across colors, so every block of the sweep has its own stream.
+        Random blockRand(seed + 0x9e3779b9u * (blockOffset + block + 1u) + 0xc2b2ae35u * parallelMoveSweep);
+        const unsigned int blockBegin = colorBegin + block * innerParallelMoveBlockSize;
+        const unsigned int blockEnd = std::min(colorEnd, blockBegin + innerParallelMoveBlockSize);
+        for (unsigned int k = blockBegin; k < blockEnd; ++k)
+          proposeMove(m_colorPositions[k], useRandomMoves, parallelMoveSweep, deltaFlow, moduleEnumeration, deltaBatch, blockRand);
+      }
+    }
+    blockOffset += numBlocks;
+
+    // Record the modules this color changes as they are before its moves. All
+    // moves to an empty module target the same one, and only the first is
+    // kept: the others would join nodes that have no link between them.
+    const auto firstMoved = static_cast<unsigned int>(movedNodes.size());
+    m_changedModules.clear();
+    m_changedModuleFlowBefore.clear();
+    m_changedModuleMembersBefore.clear();
+    const unsigned int colorStamp = ++m_colorStamp;
+    bool emptyModuleTaken = false;
+    for (unsigned int k = colorBegin; k < colorEnd; ++k) {
+      const unsigned int nodeIndex = nodeEnumeration[m_colorPositions[k]];
+      auto& proposal = proposals[nodeIndex];
+      if (!proposal.valid)
+        continue;
+      if (proposal.targetWasEmpty) {
+        if (emptyModuleTaken) {
+          proposal.valid = false;
+          continue;
+        }
+        emptyModuleTaken = true;
+      }
+      movedNodes.push_back(nodeIndex);
+      for (unsigned int module : { proposal.oldModule, proposal.newModule }) {
+        if (m_moduleChangedColor[module] == colorStamp)
+          continue;
+        m_moduleChangedColor[module] = colorStamp;
+        m_changedModules.push_back(module);
+        m_changedModuleFlowBefore.push_back(m_moduleFlowData[module]);
+        m_changedModuleMembersBefore.push_back(m_moduleMembers[module]);
+      }
+    }
+    const auto numColorMoves = static_cast<int>(movedNodes.size() - firstMoved);
+
+    // Apply the moves together. Under --deterministic on one thread, so the
+    // floating-point sums run in enumeration order.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (!deterministic)
+#endif
+    for (int k = 0; k < numColorMoves; ++k) {
+      const auto& proposal = proposals[movedNodes[firstMoved + k]];
+      InfoNode& current = *network[proposal.nodeIndex];
+      const auto& data = current.data;
+      auto& oldModule = m_moduleFlowData[proposal.oldModule];
+      auto& newModule = m_moduleFlowData[proposal.newModule];
+      const double deltaEnterExitOld = proposal.oldDelta.deltaEnter + proposal.oldDelta.deltaExit;
+      const double deltaEnterExitNew = proposal.newDelta.deltaEnter + proposal.newDelta.deltaExit;
+      detail::atomicAdd(oldModule.flow, -data.flow);
+      detail::atomicAdd(oldModule.enterFlow, deltaEnterExitOld - data.enterFlow);
+      detail::atomicAdd(oldModule.exitFlow, deltaEnterExitOld - data.exitFlow);
+      detail::atomicAdd(oldModule.teleportFlow, -data.teleportFlow);
+      detail::atomicAdd(oldModule.teleportSourceFlow, -data.teleportSourceFlow);
+      detail::atomicAdd(oldModule.teleportWeight, -data.teleportWeight);
+      detail::atomicAdd(oldModule.danglingFlow, -data.danglingFlow);
+      detail::atomicAdd(newModule.flow, data.flow);
+      detail::atomicAdd(newModule.enterFlow, data.enterFlow - deltaEnterExitNew);
+      detail::atomicAdd(newModule.exitFlow, data.exitFlow - deltaEnterExitNew);
+      detail::atomicAdd(newModule.teleportFlow, data.teleportFlow);
+      detail::atomicAdd(newModule.teleportSourceFlow, data.teleportSourceFlow);
+      detail::atomicAdd(newModule.teleportWeight, data.teleportWeight);
+      detail::atomicAdd(newModule.danglingFlow, data.danglingFlow);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      --m_moduleMembers[proposal.oldModule];
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++m_moduleMembers[proposal.newModule];
+      current.index = proposal.newModule;
+      m_nodeModule[proposal.nodeIndex] = proposal.newModule;
+    }
+
+    if (m_changedModules.empty())
+      continue;
+    updateCodelengthOnColorMoves();
+
+    // The next color proposes against these modules, including the empty one.
+    if (!m_emptyModules.empty() && m_moduleMembers[m_emptyModules.back()] > 0)
+      m_emptyModules.pop_back();
+    for (unsigned int i = 0; i < m_changedModules.size(); ++i) {
+      if (m_changedModuleMembersBefore[i] > 0 && m_moduleMembers[m_changedModules[i]] == 0)
+        m_emptyModules.push_back(m_changedModules[i]);
+    }
+  }
+
+  unsigned int numMoved = movedNodes.size();
+  Log(3).print("Inner-parallelization coloring sweep: {} colors, moved: {}\n", m_numColors, numMoved);
+
+  for (auto& proposal : proposals) {
+    if (proposal.clearDirty)
+      network[proposal.nodeIndex]->dirty = false;
+  }
+
+  for (unsigned int nodeIndex : movedNodes)
+    markNeighboursDirty(nodeIndex);
+
+  return numMoved;
+}
+
 template <typename Objective>
 inline void InfomapOptimizer<Objective>::consolidateModules(bool replaceExistingModules)
 {
@@ -1030,33 +1656,92 @@ inline void InfomapOptimizer<Objective>::consolidateModules(bool replaceExisting
     modules[moduleIndex]->addChild(node);
   }
 
-  using NodePair = std::pair<unsigned int, unsigned int>;
-  using EdgeMap = std::map<NodePair, double>;
-  EdgeMap moduleLinks;
-
-  for (auto& node : network) {
-    unsigned int module1 = node->index;
-    for (auto& e : node->outEdges()) {
-      InfoEdge& edge = *e;
-      unsigned int module2 = edge.target->index;
-      if (module1 != module2) {
-        // Use new variables to not swap module1
-        unsigned int m1 = module1, m2 = module2;
-        // If undirected, the order may be swapped to aggregate the edge on an opposite one
-        if (m_infomap->isUndirectedClustering() && m1 > m2)
-          std::swap(m1, m2);
-        auto ret = moduleLinks.insert(std::make_pair(NodePair(m1, m2), edge.data.flow));
-        if (!ret.second) {
-          ret.first->second += edge.data.flow;
-        }
+  // Aggregate the links between modules: count them per source module, write
+  // each straight into its source module's bucket, then sort each bucket by
+  // target module and node position and sum equal targets. A node's links are
+  // written by one thread in edge order, so the stable sort keeps them in that
+  // order, and each module link sums its flows in network order. The links come
+  // out ordered by (source, target), as a serial ordered-map aggregation would,
+  // for any number of threads.
+  const bool undirected = m_infomap->isUndirectedClustering();
+  const bool parallel = detail::useParallelModuleAggregation(numNodes);
+  const auto numNodesInt = static_cast<int>(numNodes);
+  (void)parallel;
+
+  // The source module of a link between modules. If undirected, the order may
+  // be swapped to aggregate the edge on an opposite one.
+  const auto sourceModule = [undirected](unsigned int m1, unsigned int m2) {
+    return undirected && m1 > m2 ? m2 : m1;
+  };
+
+  std::vector<std::size_t> moduleLinkOffsets(numNodes + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (parallel)
+#endif
+  for (int i = 0; i < numNodesInt; ++i) {
+    InfoNode& node = *network[i];
+    for (auto& e : node.outEdges()) {
+      if (e->target->index == node.index)
+        continue;
+      auto& count = moduleLinkOffsets[sourceModule(node.index, e->target->index) + 1];
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++count;
+    }
+  }
+  std::partial_sum(moduleLinkOffsets.begin(), moduleLinkOffsets.end(), moduleLinkOffsets.begin());
+
+  std::vector<detail::ModuleLink> sortedLinks(moduleLinkOffsets[numNodes]);
+  {
+    std::vector<std::size_t> next(moduleLinkOffsets.begin(), moduleLinkOffsets.end() - 1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (parallel)
+#endif
+    for (int i = 0; i < numNodesInt; ++i) {
+      InfoNode& node = *network[i];
+      for (auto& e : node.outEdges()) {
+        const unsigned int m1 = node.index, m2 = e->target->index;
+        if (m1 == m2)
+          continue;
+        const auto source = sourceModule(m1, m2);
+        std::size_t k;
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+        k = next[source]++;
+        sortedLinks[k].target = source == m1 ? m2 : m1;
+        sortedLinks[k].order = static_cast<unsigned int>(i);
+        sortedLinks[k].flow = e->data.flow;
       }
     }
   }
 
+  std::vector<std::size_t> numAggregatedLinks(numNodes, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256) if (parallel)
+#endif
+  for (int m1 = 0; m1 < numNodesInt; ++m1) {
+    const auto begin = sortedLinks.begin() + moduleLinkOffsets[m1];
+    const auto end = sortedLinks.begin() + moduleLinkOffsets[m1 + 1];
+    std::stable_sort(begin, end, [](const detail::ModuleLink& a, const detail::ModuleLink& b) {
+      return a.target < b.target || (a.target == b.target && a.order < b.order);
+    });
+    auto out = begin;
+    for (auto it = begin; it != end; ++it) {
+      if (out != begin && (out - 1)->target == it->target)
+        (out - 1)->flow += it->flow;
+      else
+        *out++ = *it;
+    }
+    numAggregatedLinks[m1] = static_cast<std::size_t>(out - begin);
+  }
+
   // Add the aggregated edge flow structure to the new modules
-  for (auto& e : moduleLinks) {
-    const auto& nodePair = e.first;
-    modules[nodePair.first]->addOutEdge(*modules[nodePair.second], 0.0, e.second);
+  for (unsigned int m1 = 0; m1 < numNodes; ++m1) {
+    const std::size_t begin = moduleLinkOffsets[m1];
+    for (std::size_t k = begin; k < begin + numAggregatedLinks[m1]; ++k)
+      modules[m1]->addOutEdge(*modules[sortedLinks[k].target], 0.0, sortedLinks[k].flow);
   }
 
   if (replaceExistingModules) {
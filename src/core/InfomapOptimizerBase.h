@@ -30,6 +30,15 @@ public:
 
   virtual void init(InfomapBase* infomap) = 0;
 
+  // Drop the per-network state of a finished run but keep the scratch buffers'
+  // capacity, so a recycled sub-Infomap can run again after init.
+  virtual void resetForReuse() noexcept = 0;
+
+  // Restart the sweep counters that seed the parallel move sweep's random
+  // streams, so a trial draws the same moves whatever ran on this instance
+  // before it.
+  virtual void restartSweeps() noexcept = 0;
+
   // ===================================================
   // IO
   // ===================================================
@@ -110,6 +119,8 @@ protected:
 
   virtual unsigned int tryMoveEachNodeIntoBestModuleInParallel() = 0;
 
+  virtual unsigned int tryMoveEachNodeIntoBestModuleByColor() = 0;
+
   virtual void consolidateModules(bool replaceExistingModules = true) = 0;
 
   virtual bool restoreConsolidatedOptimizationPointIfNoImprovement(bool forceRestore = false) = 0;
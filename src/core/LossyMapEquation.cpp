@@ -190,31 +190,35 @@ INFOMAP_HOT double LossyMapEquation::getDeltaCodelengthOnMovingNode(InfoNode& cu
   return deltaL - (corrAfter - corrBefore);
 }
 
-INFOMAP_HOT double LossyMapEquation::getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                                                           DeltaFlow& oldModuleDelta,
-                                                                           const OldSideTerms& oldSide,
-                                                                           DeltaFlow& newModuleDelta,
-                                                                           std::vector<FlowData>& moduleFlowData,
-                                                                           std::vector<unsigned int>& moduleMembers)
+INFOMAP_HOT void LossyMapEquation::getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                                                       DeltaFlow& oldModuleDelta,
+                                                                       const OldSideTerms& oldSide,
+                                                                       const DeltaFlow* candidates,
+                                                                       unsigned int numCandidates,
+                                                                       std::vector<FlowData>& moduleFlowData,
+                                                                       std::vector<unsigned int>& moduleMembers,
+                                                                       DeltaBatchScratch& batch)
 {
-  double deltaL = Base::getDeltaCodelengthOnMovingNodeHoisted(current, oldModuleDelta, oldSide, newModuleDelta, moduleFlowData, moduleMembers);
+  Base::getDeltaCodelengthOnMovingNodeBatch(current, oldModuleDelta, oldSide, candidates, numCandidates, moduleFlowData, moduleMembers, batch);
 
   unsigned int oldM = oldModuleDelta.module;
-  unsigned int newM = newModuleDelta.module;
-  if (oldM == newM)
-    return deltaL;
-
   double curFlow = current.data.flow;
   double curFlf = current.lossyFlowLogFlow;
   double curEnt = current.lossyEntropy;
 
-  double corrBefore = calcCorrection(moduleFlowData[oldM].flow, m_moduleFlowLogFlow[oldM], m_moduleEntropy[oldM])
-      + calcCorrection(moduleFlowData[newM].flow, m_moduleFlowLogFlow[newM], m_moduleEntropy[newM]);
-  double corrAfter = calcCorrection(moduleFlowData[oldM].flow - curFlow, m_moduleFlowLogFlow[oldM] - curFlf, m_moduleEntropy[oldM] - curEnt)
-      + calcCorrection(moduleFlowData[newM].flow + curFlow, m_moduleFlowLogFlow[newM] + curFlf, m_moduleEntropy[newM] + curEnt);
+  for (unsigned int j = 0; j < numCandidates; ++j) {
+    unsigned int newM = candidates[j].module;
+    if (oldM == newM)
+      continue;
 
-  // J = L_full - sum of corrections, so a correction increase lowers the objective.
-  return deltaL - (corrAfter - corrBefore);
+    double corrBefore = calcCorrection(moduleFlowData[oldM].flow, m_moduleFlowLogFlow[oldM], m_moduleEntropy[oldM])
+        + calcCorrection(moduleFlowData[newM].flow, m_moduleFlowLogFlow[newM], m_moduleEntropy[newM]);
+    double corrAfter = calcCorrection(moduleFlowData[oldM].flow - curFlow, m_moduleFlowLogFlow[oldM] - curFlf, m_moduleEntropy[oldM] - curEnt)
+        + calcCorrection(moduleFlowData[newM].flow + curFlow, m_moduleFlowLogFlow[newM] + curFlf, m_moduleEntropy[newM] + curEnt);
+
+    // J = L_full - sum of corrections, so a correction increase lowers the objective.
+    batch.deltas[j] -= corrAfter - corrBefore;
+  }
 }
 
 // ===================================================
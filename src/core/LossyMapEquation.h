@@ -94,12 +94,14 @@ public:
 
   using Base::hoistOldSide;
 
-  double getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                               DeltaFlow& oldModuleDelta,
-                                               const OldSideTerms& oldSide,
-                                               DeltaFlow& newModuleDelta,
-                                               std::vector<FlowData>& moduleFlowData,
-                                               std::vector<unsigned int>& moduleMembers);
+  void getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                           DeltaFlow& oldModuleDelta,
+                                           const OldSideTerms& oldSide,
+                                           const DeltaFlow* candidates,
+                                           unsigned int numCandidates,
+                                           std::vector<FlowData>& moduleFlowData,
+                                           std::vector<unsigned int>& moduleMembers,
+                                           DeltaBatchScratch& batch);
 
   // ===================================================
   // Consolidation
@@ -41,12 +41,12 @@ struct ModuleMemNodes {
 // visit the old module and the node's own flow are constant, so 6 of the 13
 // plogp values the delta needs are identical for every candidate module the
 // move loop probes for that node. hoistOldSide() computes them once per node;
-// getDeltaCodelengthOnMovingNodeHoisted() consumes them per candidate, keeping
-// the exact same expression structure as the unhoisted form. Plain doubles and
-// namespace scope so the (privately-inheriting) objectives can pass it around
-// by `auto` without accessibility juggling. Not bit-identical to the unhoisted
-// path at the last ulp: splitting the single 13-wide plogp_batch into a 6-wide
-// (once/node) and 7-wide (per candidate) batch regroups the SIMD lanes.
+// getDeltaCodelengthOnMovingNodeBatch() consumes them for all candidates,
+// keeping the exact same expression structure as the unhoisted form. Plain
+// doubles and namespace scope so the (privately-inheriting) objectives can pass
+// it around by `auto` without accessibility juggling. Not bit-identical to the
+// unhoisted path at the last ulp on the SIMD builds: splitting the single
+// 13-wide plogp_batch regroups the SIMD lanes. The scalar build is exact.
 struct OldSideTerms {
   double deltaEnterExitOld; // oldModuleDelta.deltaEnter + deltaExit (with teleportation folded in)
   double curEnter, curExit, curFlow; // current.data, cached to keep the hoisted delta self-contained
@@ -55,6 +55,20 @@ struct OldSideTerms {
   double plogpOldExitFlow, plogpOldExitFlowAfter;
 };
 
+// Scratch of the batched move delta, reused across node visits (one per
+// thread on the parallel paths). The 7 candidate-dependent plogp arguments are
+// laid out term by term, so each term is a contiguous run over all candidates:
+// args[t * n + j] is term t of candidate j. Terms 1, 3 and 5 are the candidate
+// modules' enter, exit and exit + flow gathered from the module flow data, the
+// others follow from them and the node's own deltas. One plogp_batch call then
+// covers every candidate, filling whole SIMD lanes where the per-candidate form
+// left a 3-wide scalar tail each time. deltas[j] is the result for candidate j.
+struct DeltaBatchScratch {
+  std::vector<double> args;
+  std::vector<double> plogps;
+  std::vector<double> deltas;
+};
+
 /**
  * Base implementation of the map equation, shared by the concrete objectives
  * (BiasedMapEquation, MemMapEquation, MetaMapEquation, RegularizedMultilayerMapEquation).
@@ -73,6 +87,11 @@ inline std::vector<ModuleMemNodes>::iterator findModuleMemNodes(std::vector<Modu
   return std::lower_bound(moduleToMemNodes.begin(), moduleToMemNodes.end(), module, [](const ModuleMemNodes& memNodes, unsigned int target) { return memNodes.module < target; });
 }
 
+inline std::vector<ModuleMemNodes>::const_iterator findModuleMemNodes(const std::vector<ModuleMemNodes>& moduleToMemNodes, unsigned int module)
+{
+  return std::lower_bound(moduleToMemNodes.begin(), moduleToMemNodes.end(), module, [](const ModuleMemNodes& memNodes, unsigned int target) { return memNodes.module < target; });
+}
+
 template <typename FlowDataType = FlowData, typename DeltaFlowDataType = DeltaFlow>
 class MapEquation {
   using ME = MapEquation<FlowDataType, DeltaFlowDataType>;
@@ -157,9 +176,12 @@ public:
     return parent.isLeafModule() ? ME::calcCodelengthOnModuleOfLeafNodes(parent) : ME::calcCodelengthOnModuleOfModules(parent);
   }
 
-  void addMemoryContributions(InfoNode& /*current*/, DeltaFlowDataType& /*oldModuleDelta*/, DeltaFlowDataType& /*newModuleDelta*/) {}
+  // Memory objectives add their physical-node terms to the move deltas here.
+  // Both forms only read objective state, so the parallel move sweep may call
+  // them from several threads at once.
+  void addMemoryContributions(InfoNode& /*current*/, DeltaFlowDataType& /*oldModuleDelta*/, DeltaFlowDataType& /*newModuleDelta*/) const {}
 
-  void addMemoryContributions(InfoNode& /*current*/, DeltaFlowDataType& /*oldModuleDelta*/, VectorMap<DeltaFlowDataType>& /*moduleDeltaFlow*/) {}
+  void addMemoryContributions(InfoNode& /*current*/, DeltaFlowDataType& /*oldModuleDelta*/, VectorMap<DeltaFlowDataType>& /*moduleDeltaFlow*/) const {}
 
   void addTeleportationFlow(InfoNode& current, const std::vector<FlowDataType>& moduleFlowData, DeltaFlowDataType& oldModuleDelta, DeltaFlowDataType& newModuleDelta);
 
@@ -173,17 +195,23 @@ public:
 
   // Precompute the old-module (per-node-constant) plogp terms of the move delta.
   // Called once per node visit by the optimize move loop; the result feeds every
-  // candidate through getDeltaCodelengthOnMovingNodeHoisted().
+  // candidate through getDeltaCodelengthOnMovingNodeBatch().
   OldSideTerms hoistOldSide(InfoNode& current,
                             DeltaFlowDataType& oldModuleDelta,
                             std::vector<FlowDataType>& moduleFlowData);
 
-  double getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                               DeltaFlowDataType& oldModuleDelta,
-                                               const OldSideTerms& oldSide,
-                                               DeltaFlowDataType& newModuleDelta,
-                                               std::vector<FlowDataType>& moduleFlowData,
-                                               std::vector<unsigned int>& /*moduleMembers*/);
+  // The delta codelength of moving the node to each of numCandidates modules,
+  // written to batch.deltas. The entry of the old module, if present, is not
+  // meaningful. Reads the module flow data only, so concurrent calls with their
+  // own scratch are safe.
+  void getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                           DeltaFlowDataType& oldModuleDelta,
+                                           const OldSideTerms& oldSide,
+                                           const DeltaFlowDataType* candidates,
+                                           unsigned int numCandidates,
+                                           std::vector<FlowDataType>& moduleFlowData,
+                                           std::vector<unsigned int>& /*moduleMembers*/,
+                                           DeltaBatchScratch& batch);
 
   // ===================================================
   // Consolidation
@@ -195,6 +223,10 @@ public:
                                     std::vector<FlowDataType>& moduleFlowData,
                                     std::vector<unsigned int>& /*moduleMembers*/);
 
+  void updateCodelengthOnChangedModules(const std::vector<unsigned int>& modules,
+                                        const std::vector<FlowDataType>& flowBefore,
+                                        const std::vector<FlowDataType>& moduleFlowData);
+
   // ===================================================
   // Debug
   // ===================================================
@@ -388,42 +420,51 @@ INFOMAP_HOT OldSideTerms MapEquation<FlowDataType, DeltaFlowDataType>::hoistOldS
 }
 
 template <typename FlowDataType, typename DeltaFlowDataType>
-INFOMAP_HOT double MapEquation<FlowDataType, DeltaFlowDataType>::getDeltaCodelengthOnMovingNodeHoisted(InfoNode& /*current*/, DeltaFlowDataType& /*oldModuleDelta*/, const OldSideTerms& oldSide, DeltaFlowDataType& newModuleDelta, std::vector<FlowDataType>& moduleFlowData, std::vector<unsigned int>&)
+INFOMAP_HOT void MapEquation<FlowDataType, DeltaFlowDataType>::getDeltaCodelengthOnMovingNodeBatch(InfoNode& /*current*/, DeltaFlowDataType& /*oldModuleDelta*/, const OldSideTerms& oldSide, const DeltaFlowDataType* candidates, unsigned int numCandidates, std::vector<FlowDataType>& moduleFlowData, std::vector<unsigned int>&, DeltaBatchScratch& batch)
 {
   using infomath::plogp_batch;
-  unsigned int newModule = newModuleDelta.module;
-  double deltaEnterExitNewModule = newModuleDelta.deltaEnter + newModuleDelta.deltaExit;
-  double deltaEnterExitOldModule = oldSide.deltaEnterExitOld;
+  const std::size_t n = numCandidates;
+  constexpr int kNumTerms = 7;
+  batch.args.resize(kNumTerms * n);
+  batch.plogps.resize(kNumTerms * n);
+  batch.deltas.resize(n);
+  double* args = batch.args.data();
+  const double* pl = batch.plogps.data();
+  double* deltas = batch.deltas.data();
 
-  FlowDataType& newMfd = moduleFlowData[newModule];
-  double newEnter = newMfd.enterFlow;
-  double newExit = newMfd.exitFlow;
-  double newExitPlusFlow = newMfd.exitFlow + newMfd.flow;
+  double deltaEnterExitOldModule = oldSide.deltaEnterExitOld;
   double curEnter = oldSide.curEnter;
   double curExit = oldSide.curExit;
   double curFlow = oldSide.curFlow;
 
-  // The 7 candidate-dependent entries of the 13-wide batch (indices 0,2,4,6,8,10,12).
-  constexpr int kPlogpBatchN = 7;
-  double args[kPlogpBatchN] = {
-    enterFlow + deltaEnterExitOldModule - deltaEnterExitNewModule,
-    newEnter,
-    newEnter + curEnter - deltaEnterExitNewModule,
-    newExit,
-    newExit + curExit - deltaEnterExitNewModule,
-    newExitPlusFlow,
-    newExitPlusFlow + curExit + curFlow - deltaEnterExitNewModule,
-  };
-  double pl[kPlogpBatchN];
-  plogp_batch(args, pl, kPlogpBatchN);
+  // Gather the candidate modules' flow into the structure-of-arrays terms.
+  for (std::size_t j = 0; j < n; ++j) {
+    const FlowDataType& newMfd = moduleFlowData[candidates[j].module];
+    args[n + j] = newMfd.enterFlow;
+    args[3 * n + j] = newMfd.exitFlow;
+    args[5 * n + j] = newMfd.exitFlow + newMfd.flow;
+  }
 
-  double delta_enter = pl[0] - enterFlow_log_enterFlow;
-  double delta_enter_log_enter = -oldSide.plogpOldEnter - pl[1] + oldSide.plogpOldEnterAfter + pl[2];
-  double delta_exit_log_exit = -oldSide.plogpOldExit - pl[3] + oldSide.plogpOldExitAfter + pl[4];
-  double delta_flow_log_flow = -oldSide.plogpOldExitFlow - pl[5] + oldSide.plogpOldExitFlowAfter + pl[6];
+  // The 7 candidate-dependent entries of the 13-wide batch in
+  // getDeltaCodelengthOnMovingNode (indices 0,2,4,6,8,10,12 there).
+  for (std::size_t j = 0; j < n; ++j) {
+    double deltaEnterExitNewModule = candidates[j].deltaEnter + candidates[j].deltaExit;
+    args[j] = enterFlow + deltaEnterExitOldModule - deltaEnterExitNewModule;
+    args[2 * n + j] = args[n + j] + curEnter - deltaEnterExitNewModule;
+    args[4 * n + j] = args[3 * n + j] + curExit - deltaEnterExitNewModule;
+    args[6 * n + j] = args[5 * n + j] + curExit + curFlow - deltaEnterExitNewModule;
+  }
 
-  double deltaL = delta_enter - delta_enter_log_enter - delta_exit_log_exit + delta_flow_log_flow;
-  return deltaL;
+  plogp_batch(args, batch.plogps.data(), static_cast<int>(kNumTerms * n));
+
+  for (std::size_t j = 0; j < n; ++j) {
+    double delta_enter = pl[j] - enterFlow_log_enterFlow;
+    double delta_enter_log_enter = -oldSide.plogpOldEnter - pl[n + j] + oldSide.plogpOldEnterAfter + pl[2 * n + j];
+    double delta_exit_log_exit = -oldSide.plogpOldExit - pl[3 * n + j] + oldSide.plogpOldExitAfter + pl[4 * n + j];
+    double delta_flow_log_flow = -oldSide.plogpOldExitFlow - pl[5 * n + j] + oldSide.plogpOldExitFlowAfter + pl[6 * n + j];
+
+    deltas[j] = delta_enter - delta_enter_log_enter - delta_exit_log_exit + delta_flow_log_flow;
+  }
 }
 
 template <typename FlowDataType, typename DeltaFlowDataType>
@@ -460,6 +501,29 @@ void MapEquation<FlowDataType, DeltaFlowDataType>::updateCodelengthOnMovingNode(
   codelength = indexCodelength + moduleCodelength;
 }
 
+/**
+ * Batched counterpart of updateCodelengthOnMovingNode, for moves already applied
+ * to moduleFlowData together (the coloring sweep). Replaces the terms of each
+ * changed module, given its flow data before the moves, with its terms now.
+ */
+template <typename FlowDataType, typename DeltaFlowDataType>
+void MapEquation<FlowDataType, DeltaFlowDataType>::updateCodelengthOnChangedModules(const std::vector<unsigned int>& modules, const std::vector<FlowDataType>& flowBefore, const std::vector<FlowDataType>& moduleFlowData)
+{
+  using infomath::plogp;
+  for (std::size_t i = 0; i < modules.size(); ++i) {
+    const auto& before = flowBefore[i];
+    const auto& after = moduleFlowData[modules[i]];
+    enterFlow += after.enterFlow - before.enterFlow;
+    enter_log_enter += plogp(after.enterFlow) - plogp(before.enterFlow);
+    exit_log_exit += plogp(after.exitFlow) - plogp(before.exitFlow);
+    flow_log_flow += plogp(after.exitFlow + after.flow) - plogp(before.exitFlow + before.flow);
+  }
+
+  enterFlow_log_enterFlow = plogp(enterFlow);
+
+  calculateCodelengthFromCodelengthTerms();
+}
+
 template <typename FlowDataType, typename DeltaFlowDataType>
 double MapEquation<FlowDataType, DeltaFlowDataType>::calcCodelengthOnModuleOfLeafNodes(const InfoNode& parent) const
 {
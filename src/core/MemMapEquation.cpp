@@ -220,8 +220,6 @@ void MemMapEquation::initPartitionOfPhysicalNodes(std::vector<InfoNode*>& nodes)
   for (auto& moduleToMemNodes : m_physToModuleToMemNodes) {
     std::sort(moduleToMemNodes.begin(), moduleToMemNodes.end(), [](const ModuleMemNodes& a, const ModuleMemNodes& b) { return a.module < b.module; });
   }
-
-  m_memoryContributionsAdded = false;
 }
 
 // ===================================================
@@ -284,7 +282,37 @@ double MemMapEquation::calcCodelengthOnModuleOfLeafNodes(const InfoNode& parent)
 
 void MemMapEquation::addMemoryContributions(InfoNode& current,
                                             DeltaFlowDataType& oldModuleDelta,
-                                            VectorMap<DeltaFlowDataType>& moduleDeltaFlow)
+                                            DeltaFlowDataType& newModuleDelta) const
+{
+  // The same terms as the VectorMap form below, for one known target module.
+  // A target without the physical node contributes plogp(physFlow) on both
+  // sides, which cancels in the codelength delta.
+  for (const auto& physData : current.physicalNodes) {
+    const ModuleToMemNodes& moduleToMemNodes = m_physToModuleToMemNodes[physData.physNodeIndex];
+    const double physFlow = physData.sumFlowFromM2Node;
+    const double plogpPhysFlow = infomath::plogp(physFlow);
+
+    auto overlapIt = findModuleMemNodes(moduleToMemNodes, oldModuleDelta.module);
+    if (overlapIt == moduleToMemNodes.end() || overlapIt->module != oldModuleDelta.module)
+      throw std::length_error("Couldn't find old module among physical node assignments.");
+
+    double oldPhysFlow = overlapIt->sumFlow;
+    double newPhysFlow = overlapIt->sumFlow - physFlow;
+    oldModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
+    oldModuleDelta.sumPlogpPhysFlow += plogpPhysFlow;
+
+    overlapIt = findModuleMemNodes(moduleToMemNodes, newModuleDelta.module);
+    const bool haveNewModule = overlapIt != moduleToMemNodes.end() && overlapIt->module == newModuleDelta.module;
+    oldPhysFlow = haveNewModule ? overlapIt->sumFlow : 0.0;
+    newPhysFlow = haveNewModule ? overlapIt->sumFlow + physFlow : physFlow;
+    newModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
+    newModuleDelta.sumPlogpPhysFlow += plogpPhysFlow;
+  }
+}
+
+void MemMapEquation::addMemoryContributions(InfoNode& current,
+                                            DeltaFlowDataType& oldModuleDelta,
+                                            VectorMap<DeltaFlowDataType>& moduleDeltaFlow) const
 {
   // Overlapping modules
   /*
@@ -305,7 +333,7 @@ void MemMapEquation::addMemoryContributions(InfoNode& current,
     // flows (old/new) still varies and stays in the loop.
     const double physFlow = physData.sumFlowFromM2Node;
     const double plogpPhysFlow = infomath::plogp(physFlow);
-    ModuleToMemNodes& moduleToMemNodes = m_physToModuleToMemNodes[physData.physNodeIndex];
+    const ModuleToMemNodes& moduleToMemNodes = m_physToModuleToMemNodes[physData.physNodeIndex];
     for (const auto& memNodes : moduleToMemNodes) {
       unsigned int moduleIndex = memNodes.module;
       if (moduleIndex == current.index) // From where the multiple assigned node is moved
@@ -324,7 +352,6 @@ void MemMapEquation::addMemoryContributions(InfoNode& current,
       }
     }
   }
-  m_memoryContributionsAdded = true;
 }
 
 INFOMAP_HOT double MemMapEquation::getDeltaCodelengthOnMovingNode(InfoNode& current,
@@ -340,20 +367,25 @@ INFOMAP_HOT double MemMapEquation::getDeltaCodelengthOnMovingNode(InfoNode& curr
   return deltaL - delta_nodeFlow_log_nodeFlow;
 }
 
-INFOMAP_HOT double MemMapEquation::getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                                                         DeltaFlowDataType& oldModuleDelta,
-                                                                         const OldSideTerms& oldSide,
-                                                                         DeltaFlowDataType& newModuleDelta,
-                                                                         std::vector<FlowDataType>& moduleFlowData,
-                                                                         std::vector<unsigned int>& moduleMembers)
+INFOMAP_HOT void MemMapEquation::getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                                                     DeltaFlowDataType& oldModuleDelta,
+                                                                     const OldSideTerms& oldSide,
+                                                                     const DeltaFlowDataType* candidates,
+                                                                     unsigned int numCandidates,
+                                                                     std::vector<FlowDataType>& moduleFlowData,
+                                                                     std::vector<unsigned int>& moduleMembers,
+                                                                     DeltaBatchScratch& batch)
 {
-  double deltaL = Base::getDeltaCodelengthOnMovingNodeHoisted(current, oldModuleDelta, oldSide, newModuleDelta, moduleFlowData, moduleMembers);
+  Base::getDeltaCodelengthOnMovingNodeBatch(current, oldModuleDelta, oldSide, candidates, numCandidates, moduleFlowData, moduleMembers, batch);
 
   // The physical-codebook old-side terms are already per-node constants:
   // addMemoryContributions() computed them once into oldModuleDelta.
-  double delta_nodeFlow_log_nodeFlow = oldModuleDelta.sumDeltaPlogpPhysFlow + newModuleDelta.sumDeltaPlogpPhysFlow + oldModuleDelta.sumPlogpPhysFlow - newModuleDelta.sumPlogpPhysFlow;
+  for (unsigned int j = 0; j < numCandidates; ++j) {
+    const auto& newModuleDelta = candidates[j];
+    double delta_nodeFlow_log_nodeFlow = oldModuleDelta.sumDeltaPlogpPhysFlow + newModuleDelta.sumDeltaPlogpPhysFlow + oldModuleDelta.sumPlogpPhysFlow - newModuleDelta.sumPlogpPhysFlow;
 
-  return deltaL - delta_nodeFlow_log_nodeFlow;
+    batch.deltas[j] -= delta_nodeFlow_log_nodeFlow;
+  }
 }
 
 // ===================================================
@@ -367,25 +399,17 @@ void MemMapEquation::updateCodelengthOnMovingNode(InfoNode& current,
                                                   std::vector<unsigned int>& moduleMembers)
 {
   Base::updateCodelengthOnMovingNode(current, oldModuleDelta, newModuleDelta, moduleFlowData, moduleMembers);
-  if (m_memoryContributionsAdded)
-    updatePhysicalNodes(current, oldModuleDelta.module, newModuleDelta.module);
-  else
-    addMemoryContributionsAndUpdatePhysicalNodes(current, oldModuleDelta, newModuleDelta);
+  // Every caller has added the memory contributions for this move to the
+  // deltas already (addMemoryContributions), so only the physical-node map is
+  // left to update. Keeping that out of the delta evaluation is what lets the
+  // parallel move sweep propose moves concurrently and apply them at commit.
+  updatePhysicalNodes(current, oldModuleDelta.module, newModuleDelta.module);
 
   double delta_nodeFlow_log_nodeFlow = oldModuleDelta.sumDeltaPlogpPhysFlow + newModuleDelta.sumDeltaPlogpPhysFlow + oldModuleDelta.sumPlogpPhysFlow - newModuleDelta.sumPlogpPhysFlow;
 
   nodeFlow_log_nodeFlow += delta_nodeFlow_log_nodeFlow;
   moduleCodelength -= delta_nodeFlow_log_nodeFlow;
   codelength -= delta_nodeFlow_log_nodeFlow;
-
-  // The flag marks that the memory contributions for THIS move were already
-  // accumulated onto the deltas by addMemoryContributions() (the optimize
-  // candidate-evaluation path). It is consumed by this one move; reset it so a
-  // following standalone moveNodeToPredefinedModule() — e.g. the single-node
-  // "drag along" in tryMoveEachNodeIntoBestModule(), which passes fresh
-  // zero-initialised deltas — recomputes its own contributions instead of
-  // updating the physical-node map while leaving nodeFlow_log_nodeFlow stale.
-  m_memoryContributionsAdded = false;
 }
 
 void MemMapEquation::updatePhysicalNodes(InfoNode& current, unsigned int oldModuleIndex, unsigned int bestModuleIndex)
@@ -414,47 +438,6 @@ void MemMapEquation::updatePhysicalNodes(InfoNode& current, unsigned int oldModu
   }
 }
 
-void MemMapEquation::addMemoryContributionsAndUpdatePhysicalNodes(InfoNode& current, DeltaFlowDataType& oldModuleDelta, DeltaFlowDataType& newModuleDelta)
-{
-  unsigned int oldModuleIndex = oldModuleDelta.module;
-  unsigned int bestModuleIndex = newModuleDelta.module;
-
-  // For all multiple assigned nodes
-  for (const auto& physData : current.physicalNodes) {
-    ModuleToMemNodes& moduleToMemNodes = m_physToModuleToMemNodes[physData.physNodeIndex];
-
-    // Remove contribution to old module
-    auto overlapIt = findModuleMemNodes(moduleToMemNodes, oldModuleIndex);
-    if (overlapIt == moduleToMemNodes.end() || overlapIt->module != oldModuleIndex)
-      throw std::length_error("Couldn't find old module among physical node assignments.");
-
-    double oldPhysFlow = overlapIt->sumFlow;
-    double newPhysFlow = overlapIt->sumFlow - physData.sumFlowFromM2Node;
-    oldModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
-    oldModuleDelta.sumPlogpPhysFlow += infomath::plogp(physData.sumFlowFromM2Node);
-    overlapIt->sumFlow -= physData.sumFlowFromM2Node;
-    if (--overlapIt->numMemNodes == 0)
-      moduleToMemNodes.erase(overlapIt);
-
-    // Add contribution to new module
-    overlapIt = findModuleMemNodes(moduleToMemNodes, bestModuleIndex);
-    if (overlapIt == moduleToMemNodes.end() || overlapIt->module != bestModuleIndex) {
-      moduleToMemNodes.insert(overlapIt, ModuleMemNodes(bestModuleIndex, 1, physData.sumFlowFromM2Node));
-      oldPhysFlow = 0.0;
-      newPhysFlow = physData.sumFlowFromM2Node;
-      newModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
-      newModuleDelta.sumPlogpPhysFlow += infomath::plogp(physData.sumFlowFromM2Node);
-    } else {
-      oldPhysFlow = overlapIt->sumFlow;
-      newPhysFlow = overlapIt->sumFlow + physData.sumFlowFromM2Node;
-      newModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
-      newModuleDelta.sumPlogpPhysFlow += infomath::plogp(physData.sumFlowFromM2Node);
-      ++overlapIt->numMemNodes;
-      overlapIt->sumFlow += physData.sumFlowFromM2Node;
-    }
-  }
-}
-
 void MemMapEquation::consolidateModules(std::vector<InfoNode*>& modules)
 {
   for (unsigned int i = 0; i < m_numPhysicalNodes; ++i) {
@@ -68,7 +68,9 @@ public:
 
   double calcCodelength(const InfoNode& parent) const;
 
-  void addMemoryContributions(InfoNode& current, DeltaFlowDataType& oldModuleDelta, VectorMap<DeltaFlowDataType>& moduleDeltaFlow);
+  void addMemoryContributions(InfoNode& current, DeltaFlowDataType& oldModuleDelta, DeltaFlowDataType& newModuleDelta) const;
+
+  void addMemoryContributions(InfoNode& current, DeltaFlowDataType& oldModuleDelta, VectorMap<DeltaFlowDataType>& moduleDeltaFlow) const;
 
   using Base::addTeleportationFlow;
 
@@ -80,12 +82,14 @@ public:
 
   using Base::hoistOldSide;
 
-  double getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                               DeltaFlowDataType& oldModuleDelta,
-                                               const OldSideTerms& oldSide,
-                                               DeltaFlowDataType& newModuleDelta,
-                                               std::vector<FlowDataType>& moduleFlowData,
-                                               std::vector<unsigned int>& moduleMembers);
+  void getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                           DeltaFlowDataType& oldModuleDelta,
+                                           const OldSideTerms& oldSide,
+                                           const DeltaFlowDataType* candidates,
+                                           unsigned int numCandidates,
+                                           std::vector<FlowDataType>& moduleFlowData,
+                                           std::vector<unsigned int>& moduleMembers,
+                                           DeltaBatchScratch& batch);
 
   // ===================================================
   // Consolidation
@@ -137,8 +141,6 @@ private:
 
   void updatePhysicalNodes(InfoNode& current, unsigned int oldModuleIndex, unsigned int bestModuleIndex);
 
-  void addMemoryContributionsAndUpdatePhysicalNodes(InfoNode& current, DeltaFlowDataType& oldModuleDelta, DeltaFlowDataType& newModuleDelta);
-
 public:
   // ===================================================
   // Public member variables
@@ -168,7 +170,6 @@ private:
 
   std::vector<ModuleToMemNodes> m_physToModuleToMemNodes; // vector[physicalNodeID] sorted vector of {moduleID, #memNodes, sumFlow}
   unsigned int m_numPhysicalNodes = 0;
-  bool m_memoryContributionsAdded = false;
 };
 
 } // namespace infomap
@@ -186,53 +186,55 @@ INFOMAP_HOT double MetaMapEquation::getDeltaCodelengthOnMovingNode(InfoNode& cur
   return deltaL + deltaMetaL * metaDataRate;
 }
 
-INFOMAP_HOT double MetaMapEquation::getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                                                          DeltaFlow& oldModuleDelta,
-                                                                          const OldSideTerms& oldSide,
-                                                                          DeltaFlow& newModuleDelta,
-                                                                          std::vector<FlowData>& moduleFlowData,
-                                                                          std::vector<unsigned int>& moduleMembers)
+INFOMAP_HOT void MetaMapEquation::getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                                                      DeltaFlow& oldModuleDelta,
+                                                                      const OldSideTerms& oldSide,
+                                                                      const DeltaFlow* candidates,
+                                                                      unsigned int numCandidates,
+                                                                      std::vector<FlowData>& moduleFlowData,
+                                                                      std::vector<unsigned int>& moduleMembers,
+                                                                      DeltaBatchScratch& batch)
 {
-  double deltaL = Base::getDeltaCodelengthOnMovingNodeHoisted(current, oldModuleDelta, oldSide, newModuleDelta, moduleFlowData, moduleMembers);
-
-  double deltaMetaL = 0.0;
+  Base::getDeltaCodelengthOnMovingNodeBatch(current, oldModuleDelta, oldSide, candidates, numCandidates, moduleFlowData, moduleMembers, batch);
 
   unsigned int oldModuleIndex = oldModuleDelta.module;
-  unsigned int newModuleIndex = newModuleDelta.module;
 
-  // Remove codelength of old and new module before changes
-  deltaMetaL -= getCurrentModuleMetaCodelength(oldModuleIndex, current, 0);
-  deltaMetaL -= getCurrentModuleMetaCodelength(newModuleIndex, current, 0);
-  // Add codelength of old module with current node removed
-  deltaMetaL += getCurrentModuleMetaCodelength(oldModuleIndex, current, -1);
-  // Add codelength of old module with current node added
-  deltaMetaL += getCurrentModuleMetaCodelength(newModuleIndex, current, 1);
+  // Old-module terms are the same for every candidate.
+  double deltaMetaOld = -getCurrentModuleMetaCodelength(oldModuleIndex, current, 0);
+  double deltaMetaOldRemoved = getCurrentModuleMetaCodelength(oldModuleIndex, current, -1);
 
-  return deltaL + deltaMetaL * metaDataRate;
+  for (unsigned int j = 0; j < numCandidates; ++j) {
+    unsigned int newModuleIndex = candidates[j].module;
+    if (newModuleIndex == oldModuleIndex)
+      continue;
+
+    double deltaMetaL = deltaMetaOld;
+
+    // Remove codelength of new module before changes
+    deltaMetaL -= getCurrentModuleMetaCodelength(newModuleIndex, current, 0);
+    // Add codelength of old module with current node removed
+    deltaMetaL += deltaMetaOldRemoved;
+    // Add codelength of new module with current node added
+    deltaMetaL += getCurrentModuleMetaCodelength(newModuleIndex, current, 1);
+
+    batch.deltas[j] += deltaMetaL * metaDataRate;
+  }
 }
 
-double MetaMapEquation::getCurrentModuleMetaCodelength(unsigned int module, InfoNode& current, int addRemoveOrNothing)
+double MetaMapEquation::getCurrentModuleMetaCodelength(unsigned int module, const InfoNode& current, int addRemoveOrNothing) const
 {
-  auto& currentMetaCollection = m_moduleToMetaCollection[module];
+  // Read-only, so the parallel move sweep can evaluate moves from several
+  // threads at once. A module without a collection yet is empty.
+  static const MetaCollection emptyMetaCollection;
+  auto it = m_moduleToMetaCollection.find(module);
+  const MetaCollection& currentMetaCollection = it != m_moduleToMetaCollection.end() ? it->second : emptyMetaCollection;
   const MetaCollection* nodeMeta = current.metaCollectionPtr();
 
-  double moduleMetaCodelength = 0.0;
-
   if (addRemoveOrNothing == 0 || nodeMeta == nullptr) {
-    moduleMetaCodelength = currentMetaCollection.calculateEntropy();
+    return currentMetaCollection.calculateEntropy();
   }
-  // If add or remove, do the change, calculate new codelength and then undo the change
-  else if (addRemoveOrNothing == 1) {
-    currentMetaCollection.add(*nodeMeta);
-    moduleMetaCodelength = currentMetaCollection.calculateEntropy();
-    currentMetaCollection.remove(*nodeMeta);
-  } else {
-    currentMetaCollection.remove(*nodeMeta);
-    moduleMetaCodelength = currentMetaCollection.calculateEntropy();
-    currentMetaCollection.add(*nodeMeta);
-  }
-
-  return moduleMetaCodelength;
+  // If add or remove, calculate the codelength as if the change was done
+  return currentMetaCollection.calculateEntropyWith(*nodeMeta, addRemoveOrNothing);
 }
 
 // ===================================================
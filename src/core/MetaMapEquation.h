@@ -86,12 +86,14 @@ public:
 
   using Base::hoistOldSide;
 
-  double getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                               DeltaFlow& oldModuleDelta,
-                                               const OldSideTerms& oldSide,
-                                               DeltaFlow& newModuleDelta,
-                                               std::vector<FlowData>& moduleFlowData,
-                                               std::vector<unsigned int>& moduleMembers);
+  void getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                           DeltaFlow& oldModuleDelta,
+                                           const OldSideTerms& oldSide,
+                                           const DeltaFlow* candidates,
+                                           unsigned int numCandidates,
+                                           std::vector<FlowData>& moduleFlowData,
+                                           std::vector<unsigned int>& moduleMembers,
+                                           DeltaBatchScratch& batch);
 
   // ===================================================
   // Consolidation
@@ -160,7 +162,7 @@ private:
    * @param addRemoveOrNothing +1, -1 or 0 to calculate codelength
    * as if current node was added, removed or untouched in current module
    */
-  double getCurrentModuleMetaCodelength(unsigned int module, InfoNode& current, int addRemoveOrNothing);
+  double getCurrentModuleMetaCodelength(unsigned int module, const InfoNode& current, int addRemoveOrNothing) const;
 
   // ===================================================
   // Private member variables
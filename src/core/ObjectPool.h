@@ -146,6 +146,15 @@ public:
 
   std::size_t liveCount() const noexcept { return m_liveCount; }
   std::size_t chunkCount() const noexcept { return m_chunks.size(); }
+
+  // Slots held across all chunks, live or free.
+  std::size_t capacity() const noexcept
+  {
+    std::size_t total = 0;
+    for (const auto& chunk : m_chunks)
+      total += chunk.capacity;
+    return total;
+  }
 };
 
 } // namespace infomap
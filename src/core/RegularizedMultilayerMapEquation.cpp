@@ -219,8 +219,6 @@ void RegularizedMultilayerMapEquation::initPartitionOfPhysicalNodes(std::vector<
   for (auto& moduleToMemNodes : m_physToModuleToMemNodes) {
     std::sort(moduleToMemNodes.begin(), moduleToMemNodes.end(), [](const ModuleMemNodes& a, const ModuleMemNodes& b) { return a.module < b.module; });
   }
-
-  m_memoryContributionsAdded = false;
 }
 
 void RegularizedMultilayerMapEquation::initPartitionLayerTeleFlowData(std::vector<InfoNode*>& nodes)
@@ -294,7 +292,35 @@ double RegularizedMultilayerMapEquation::calcCodelengthOnModuleOfLeafNodes(const
 
 void RegularizedMultilayerMapEquation::addMemoryContributions(InfoNode& current,
                                                               DeltaFlowDataType& oldModuleDelta,
-                                                              VectorMap<DeltaFlowDataType>& moduleDeltaFlow)
+                                                              DeltaFlowDataType& newModuleDelta) const
+{
+  // The same terms as the VectorMap form below, for one known target module,
+  // as in MemMapEquation.
+  for (const auto& physData : current.physicalNodes) {
+    const ModuleToMemNodes& moduleToMemNodes = m_physToModuleToMemNodes[physData.physNodeIndex];
+    const double plogpPhysFlow = infomath::plogp(physData.sumFlowFromM2Node);
+
+    auto overlapIt = findModuleMemNodes(moduleToMemNodes, oldModuleDelta.module);
+    if (overlapIt == moduleToMemNodes.end() || overlapIt->module != oldModuleDelta.module)
+      throw std::length_error("Couldn't find old module among physical node assignments.");
+
+    double oldPhysFlow = overlapIt->sumFlow;
+    double newPhysFlow = overlapIt->sumFlow - physData.sumFlowFromM2Node;
+    oldModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
+    oldModuleDelta.sumPlogpPhysFlow += plogpPhysFlow;
+
+    overlapIt = findModuleMemNodes(moduleToMemNodes, newModuleDelta.module);
+    const bool haveNewModule = overlapIt != moduleToMemNodes.end() && overlapIt->module == newModuleDelta.module;
+    oldPhysFlow = haveNewModule ? overlapIt->sumFlow : 0.0;
+    newPhysFlow = haveNewModule ? overlapIt->sumFlow + physData.sumFlowFromM2Node : physData.sumFlowFromM2Node;
+    newModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
+    newModuleDelta.sumPlogpPhysFlow += plogpPhysFlow;
+  }
+}
+
+void RegularizedMultilayerMapEquation::addMemoryContributions(InfoNode& current,
+                                                              DeltaFlowDataType& oldModuleDelta,
+                                                              VectorMap<DeltaFlowDataType>& moduleDeltaFlow) const
 {
   // Overlapping modules
   /*
@@ -308,8 +334,8 @@ void RegularizedMultilayerMapEquation::addMemoryContributions(InfoNode& current,
   auto& physicalNodes = current.physicalNodes;
   unsigned int numPhysicalNodes = physicalNodes.size();
   for (unsigned int i = 0; i < numPhysicalNodes; ++i) {
-    PhysData& physData = physicalNodes[i];
-    ModuleToMemNodes& moduleToMemNodes = m_physToModuleToMemNodes[physData.physNodeIndex];
+    const PhysData& physData = physicalNodes[i];
+    const ModuleToMemNodes& moduleToMemNodes = m_physToModuleToMemNodes[physData.physNodeIndex];
     for (const auto& memNodes : moduleToMemNodes) {
       unsigned int moduleIndex = memNodes.module;
       if (moduleIndex == current.index) // From where the multiple assigned node is moved
@@ -329,7 +355,6 @@ void RegularizedMultilayerMapEquation::addMemoryContributions(InfoNode& current,
       }
     }
   }
-  m_memoryContributionsAdded = true;
 }
 
 /**
@@ -340,7 +365,7 @@ void RegularizedMultilayerMapEquation::addTeleportationFlow(InfoNode& current, c
   // TODO: Optimize: check if teleportFlow is zero and skip this (true for multilayer regularization now)
   Base::addTeleportationFlow(current, moduleFlowData, oldModuleDelta, newModuleDelta);
 
-  auto& oldModuleLayerFlowData = m_moduleLayerTeleFlowData[oldModuleDelta.module];
+  const auto& oldModuleLayerFlowData = m_moduleLayerTeleFlowData[oldModuleDelta.module];
 
   for (const auto& nodeLayerFlow : current.layerTeleFlowData()) {
     auto itModuleLayer = oldModuleLayerFlowData.find(nodeLayerFlow.layerId);
@@ -351,7 +376,7 @@ void RegularizedMultilayerMapEquation::addTeleportationFlow(InfoNode& current, c
     }
   }
 
-  auto& newModuleLayerFlowData = m_moduleLayerTeleFlowData[newModuleDelta.module];
+  const auto& newModuleLayerFlowData = m_moduleLayerTeleFlowData[newModuleDelta.module];
 
   for (const auto& nodeLayerFlow : current.layerTeleFlowData()) {
     auto itModuleLayer = newModuleLayerFlowData.find(nodeLayerFlow.layerId);
@@ -376,7 +401,7 @@ void RegularizedMultilayerMapEquation::addTeleportationFlow(InfoNode& current, c
     double deltaExit = 0;
 
     if (moduleIndex == current.index) {
-      auto& oldModuleLayerFlowData = m_moduleLayerTeleFlowData[moduleIndex];
+      const auto& oldModuleLayerFlowData = m_moduleLayerTeleFlowData[moduleIndex];
 
       // A single node here can be multiple nodes moving (coarse-tune), so need to check all layers
       for (const auto& nodeLayerFlow : current.layerTeleFlowData()) {
@@ -388,7 +413,7 @@ void RegularizedMultilayerMapEquation::addTeleportationFlow(InfoNode& current, c
         }
       }
     } else {
-      auto& newModuleLayerFlowData = m_moduleLayerTeleFlowData[moduleIndex];
+      const auto& newModuleLayerFlowData = m_moduleLayerTeleFlowData[moduleIndex];
 
       for (const auto& nodeLayerFlow : current.layerTeleFlowData()) {
         auto itModuleLayer = newModuleLayerFlowData.find(nodeLayerFlow.layerId);
@@ -416,18 +441,23 @@ double RegularizedMultilayerMapEquation::getDeltaCodelengthOnMovingNode(InfoNode
   return deltaL - delta_nodeFlow_log_nodeFlow;
 }
 
-double RegularizedMultilayerMapEquation::getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                                                               DeltaFlowDataType& oldModuleDelta,
-                                                                               const OldSideTerms& oldSide,
-                                                                               DeltaFlowDataType& newModuleDelta,
-                                                                               std::vector<FlowDataType>& moduleFlowData,
-                                                                               std::vector<unsigned int>& moduleMembers)
+void RegularizedMultilayerMapEquation::getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                                                           DeltaFlowDataType& oldModuleDelta,
+                                                                           const OldSideTerms& oldSide,
+                                                                           const DeltaFlowDataType* candidates,
+                                                                           unsigned int numCandidates,
+                                                                           std::vector<FlowDataType>& moduleFlowData,
+                                                                           std::vector<unsigned int>& moduleMembers,
+                                                                           DeltaBatchScratch& batch)
 {
-  double deltaL = Base::getDeltaCodelengthOnMovingNodeHoisted(current, oldModuleDelta, oldSide, newModuleDelta, moduleFlowData, moduleMembers);
+  Base::getDeltaCodelengthOnMovingNodeBatch(current, oldModuleDelta, oldSide, candidates, numCandidates, moduleFlowData, moduleMembers, batch);
 
-  double delta_nodeFlow_log_nodeFlow = oldModuleDelta.sumDeltaPlogpPhysFlow + newModuleDelta.sumDeltaPlogpPhysFlow + oldModuleDelta.sumPlogpPhysFlow - newModuleDelta.sumPlogpPhysFlow;
+  for (unsigned int j = 0; j < numCandidates; ++j) {
+    const auto& newModuleDelta = candidates[j];
+    double delta_nodeFlow_log_nodeFlow = oldModuleDelta.sumDeltaPlogpPhysFlow + newModuleDelta.sumDeltaPlogpPhysFlow + oldModuleDelta.sumPlogpPhysFlow - newModuleDelta.sumPlogpPhysFlow;
 
-  return deltaL - delta_nodeFlow_log_nodeFlow;
+    batch.deltas[j] -= delta_nodeFlow_log_nodeFlow;
+  }
 }
 
 // ===================================================
@@ -441,10 +471,10 @@ void RegularizedMultilayerMapEquation::updateCodelengthOnMovingNode(InfoNode& cu
                                                                     std::vector<unsigned int>& moduleMembers)
 {
   Base::updateCodelengthOnMovingNode(current, oldModuleDelta, newModuleDelta, moduleFlowData, moduleMembers);
-  if (m_memoryContributionsAdded)
-    updatePhysicalNodes(current, oldModuleDelta.module, newModuleDelta.module);
-  else
-    addMemoryContributionsAndUpdatePhysicalNodes(current, oldModuleDelta, newModuleDelta);
+  // The deltas already carry this move's memory contributions and layer
+  // teleportation flow, so only the physical-node map and the per-module layer
+  // teleportation state are left to update, as in MemMapEquation.
+  updatePhysicalNodes(current, oldModuleDelta.module, newModuleDelta.module);
 
   removeLayerTeleFlow(oldModuleDelta.module, current.layerTeleFlowData());
   addLayerTeleFlow(newModuleDelta.module, current.layerTeleFlowData());
@@ -454,13 +484,6 @@ void RegularizedMultilayerMapEquation::updateCodelengthOnMovingNode(InfoNode& cu
   nodeFlow_log_nodeFlow += delta_nodeFlow_log_nodeFlow;
   moduleCodelength -= delta_nodeFlow_log_nodeFlow;
   codelength -= delta_nodeFlow_log_nodeFlow;
-
-  // The flag marks that this move's memory contributions were already added to
-  // the deltas by addMemoryContributions(). Consumed by this one move; reset so
-  // a following standalone moveNodeToPredefinedModule() (fresh zero deltas)
-  // recomputes them instead of leaving nodeFlow_log_nodeFlow stale. See the
-  // matching note in MemMapEquation::updateCodelengthOnMovingNode.
-  m_memoryContributionsAdded = false;
 }
 
 void RegularizedMultilayerMapEquation::addLayerTeleFlow(unsigned int moduleIndex, const std::vector<LayerTeleFlowData>& layerTeleFlowData)
@@ -513,47 +536,6 @@ void RegularizedMultilayerMapEquation::updatePhysicalNodes(InfoNode& current, un
   }
 }
 
-void RegularizedMultilayerMapEquation::addMemoryContributionsAndUpdatePhysicalNodes(InfoNode& current, DeltaFlowDataType& oldModuleDelta, DeltaFlowDataType& newModuleDelta)
-{
-  unsigned int oldModuleIndex = oldModuleDelta.module;
-  unsigned int bestModuleIndex = newModuleDelta.module;
-
-  // For all multiple assigned nodes
-  for (const auto& physData : current.physicalNodes) {
-    ModuleToMemNodes& moduleToMemNodes = m_physToModuleToMemNodes[physData.physNodeIndex];
-
-    // Remove contribution to old module
-    auto overlapIt = findModuleMemNodes(moduleToMemNodes, oldModuleIndex);
-    if (overlapIt == moduleToMemNodes.end() || overlapIt->module != oldModuleIndex)
-      throw std::length_error("Couldn't find old module among physical node assignments.");
-
-    double oldPhysFlow = overlapIt->sumFlow;
-    double newPhysFlow = overlapIt->sumFlow - physData.sumFlowFromM2Node;
-    oldModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
-    oldModuleDelta.sumPlogpPhysFlow += infomath::plogp(physData.sumFlowFromM2Node);
-    overlapIt->sumFlow -= physData.sumFlowFromM2Node;
-    if (--overlapIt->numMemNodes == 0)
-      moduleToMemNodes.erase(overlapIt);
-
-    // Add contribution to new module
-    overlapIt = findModuleMemNodes(moduleToMemNodes, bestModuleIndex);
-    if (overlapIt == moduleToMemNodes.end() || overlapIt->module != bestModuleIndex) {
-      moduleToMemNodes.insert(overlapIt, ModuleMemNodes(bestModuleIndex, 1, physData.sumFlowFromM2Node));
-      oldPhysFlow = 0.0;
-      newPhysFlow = physData.sumFlowFromM2Node;
-      newModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
-      newModuleDelta.sumPlogpPhysFlow += infomath::plogp(physData.sumFlowFromM2Node);
-    } else {
-      oldPhysFlow = overlapIt->sumFlow;
-      newPhysFlow = overlapIt->sumFlow + physData.sumFlowFromM2Node;
-      newModuleDelta.sumDeltaPlogpPhysFlow += infomath::plogp(newPhysFlow) - infomath::plogp(oldPhysFlow);
-      newModuleDelta.sumPlogpPhysFlow += infomath::plogp(physData.sumFlowFromM2Node);
-      ++overlapIt->numMemNodes;
-      overlapIt->sumFlow += physData.sumFlowFromM2Node;
-    }
-  }
-}
-
 void RegularizedMultilayerMapEquation::consolidateModules(std::vector<InfoNode*>& modules)
 {
   for (unsigned int i = 0; i < m_numPhysicalNodes; ++i) {
@@ -68,7 +68,9 @@ public:
 
   double calcCodelength(const InfoNode& parent) const;
 
-  void addMemoryContributions(InfoNode& current, DeltaFlowDataType& oldModuleDelta, VectorMap<DeltaFlowDataType>& moduleDeltaFlow);
+  void addMemoryContributions(InfoNode& current, DeltaFlowDataType& oldModuleDelta, DeltaFlowDataType& newModuleDelta) const;
+
+  void addMemoryContributions(InfoNode& current, DeltaFlowDataType& oldModuleDelta, VectorMap<DeltaFlowDataType>& moduleDeltaFlow) const;
 
   void addTeleportationFlow(InfoNode& current, const std::vector<FlowDataType>& moduleFlowData, DeltaFlowDataType& oldModuleDelta, DeltaFlowDataType& newModuleDelta);
   void addTeleportationFlow(InfoNode& current, const std::vector<FlowDataType>& moduleFlowData, VectorMap<DeltaFlowDataType>& moduleDeltaFlow);
@@ -81,12 +83,14 @@ public:
 
   using Base::hoistOldSide;
 
-  double getDeltaCodelengthOnMovingNodeHoisted(InfoNode& current,
-                                               DeltaFlowDataType& oldModuleDelta,
-                                               const OldSideTerms& oldSide,
-                                               DeltaFlowDataType& newModuleDelta,
-                                               std::vector<FlowDataType>& moduleFlowData,
-                                               std::vector<unsigned int>& moduleMembers);
+  void getDeltaCodelengthOnMovingNodeBatch(InfoNode& current,
+                                           DeltaFlowDataType& oldModuleDelta,
+                                           const OldSideTerms& oldSide,
+                                           const DeltaFlowDataType* candidates,
+                                           unsigned int numCandidates,
+                                           std::vector<FlowDataType>& moduleFlowData,
+                                           std::vector<unsigned int>& moduleMembers,
+                                           DeltaBatchScratch& batch);
 
   // ===================================================
   // Consolidation
@@ -139,8 +143,6 @@ private:
 
   void updatePhysicalNodes(InfoNode& current, unsigned int oldModuleIndex, unsigned int bestModuleIndex);
 
-  void addMemoryContributionsAndUpdatePhysicalNodes(InfoNode& current, DeltaFlowDataType& oldModuleDelta, DeltaFlowDataType& newModuleDelta);
-
   void addLayerTeleFlow(unsigned int moduleIndex, const std::vector<LayerTeleFlowData>& layerTeleFlowData);
   void removeLayerTeleFlow(unsigned int moduleIndex, const std::vector<LayerTeleFlowData>& layerTeleFlowData);
 
@@ -175,7 +177,6 @@ private:
   std::vector<ModuleToMemNodes> m_physToModuleToMemNodes; // vector[physicalNodeID] sorted vector of {moduleID, #memNodes, sumFlow}
   std::vector<LayerTeleFlowMap> m_moduleLayerTeleFlowData; // vector[moduleID] map<layerID, layer teleport flow>
   unsigned int m_numPhysicalNodes = 0;
-  bool m_memoryContributionsAdded = false;
 };
 
 } // namespace infomap
@@ -325,6 +325,7 @@ void StateNetwork::clear()
   m_physNodes.clear();
   m_outWeights.clear();
   m_names.clear();
+  m_initialFlow.clear();
 
   m_linksFinalized = false;
   m_rawLinkCount = 0;
@@ -97,6 +97,8 @@ public:
 
 protected:
   friend class FlowCalculator;
+  friend class FlowCache;
+  friend void calculateFlow(StateNetwork&, const Config&);
   // Config
   Config m_config;
   // Network
@@ -147,6 +149,11 @@ protected:
   bool m_flowConverged = true;
   unsigned int m_flowIterations = 0;
   double m_flowError = 0.0;
+  // The --flow-cache file for this network, and whether the flow was read from it.
+  std::string m_flowCacheFile;
+  bool m_flowCacheHit = false;
+  // Starting node flow for the power iteration by state id, for a warm start.
+  std::map<unsigned int, double> m_initialFlow;
 
   // Bipartite
   unsigned int m_bipartiteStartId = 0;
@@ -287,6 +294,22 @@ public:
   bool flowConverged() const { return m_flowConverged; }
   unsigned int flowIterations() const { return m_flowIterations; }
   double flowError() const { return m_flowError; }
+  //! The --flow-cache file used for this network, empty without --flow-cache.
+  const std::string& flowCacheFile() const { return m_flowCacheFile; }
+  //! Whether the flow was read from flowCacheFile() instead of calculated.
+  bool flowCacheHit() const { return m_flowCacheHit; }
+
+  /**
+   * Start the power iteration from this node flow instead of from the degrees,
+   * for example the flow reported for a previous snapshot of a slowly changing
+   * network. Keyed by state id (node id for first-order networks). If nodes are
+   * missing from it, one power iteration from the degrees is taken first and
+   * they keep its flow; that step counts in flowIterations(). The whole is
+   * normalized. Used by directed flow, also regularized, except with bipartite
+   * teleportation; the other flow models ignore it.
+   */
+  void setInitialFlow(std::map<unsigned int, double> flow) { m_initialFlow = std::move(flow); }
+  const std::map<unsigned int, double>& initialFlow() const { return m_initialFlow; }
 
   bool haveNodeWeights() const { return m_haveNodeWeights; }
   bool haveStateNodeWeights() const { return m_haveStateNodeWeights; }
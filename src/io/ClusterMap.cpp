@@ -202,10 +202,7 @@ void ClusterMap::readClu(const std::string& filename, bool includeFlow, const st
       throw std::runtime_error(fmt::format(FMT_STRING("Couldn't parse node key and cluster id from line '{}': expected two non-negative integers, got '{}' and '{}'"), line, stateIdToken, moduleIdToken));
 
     auto flow = 0.0;
-    if (lineStream >> flow) {
-      if (includeFlow)
-        m_flowData[stateId] = flow;
-    }
+    const auto haveFlow = static_cast<bool>(lineStream >> flow);
 
     auto multilayerNodeFound = false;
     if (isMultilayer) {
@@ -232,6 +229,9 @@ void ClusterMap::readClu(const std::string& filename, bool includeFlow, const st
     }
 
     m_clusterIds[stateId] = moduleId;
+    // Keyed after the multilayer remapping, like the cluster id.
+    if (includeFlow && haveFlow)
+      m_flowData[stateId] = flow;
   }
 }
 
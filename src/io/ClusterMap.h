@@ -47,6 +47,9 @@ public:
 
   const TreePaths& treePaths() const noexcept { return m_treePaths; }
 
+  //! Node flow by node id, read only when readClusterData was asked to include it.
+  const std::map<unsigned int, double>& flowData() const noexcept { return m_flowData; }
+
   const std::string& extension() const noexcept { return m_extension; }
 
   TreeLeafIdType treeLeafIdType() const noexcept { return m_treeLeafIdType; }
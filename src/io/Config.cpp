@@ -175,6 +175,20 @@ namespace {
     }
   }
 
+  void validateInnerParallelStrategy(const Config& config)
+  {
+    if (config.innerParallelStrategy != "proposals" && config.innerParallelStrategy != "coloring") {
+      throw std::runtime_error("--inner-parallel-strategy must be 'proposals' or 'coloring', got '" + config.innerParallelStrategy + "'");
+    }
+  }
+
+  void validateFlowAcceleration(const Config& config)
+  {
+    if (config.flowAcceleration != "none" && config.flowAcceleration != "quadratic") {
+      throw std::runtime_error("--flow-acceleration must be 'none' or 'quadratic', got '" + config.flowAcceleration + "'");
+    }
+  }
+
 #if INFOMAP_FEATURE_LOSSY_MAP_EQUATION
   void applyAndValidateLossyInteraction(Config& config)
   {
@@ -496,6 +510,8 @@ void Config::adaptDefaults()
   validateRequiredCliOutput(*this);
   applyOptionInteractions(*this);
   validateConvergeTrials(*this);
+  validateInnerParallelStrategy(*this);
+  validateFlowAcceleration(*this);
   validateMatchableMultilayerIds(*this);
 #if INFOMAP_FEATURE_LOSSY_MAP_EQUATION
   applyAndValidateLossyInteraction(*this);
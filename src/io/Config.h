@@ -97,6 +97,9 @@ struct Config {
   unsigned int maxFlowIterations = 400;
   unsigned int minFlowIterations = 50;
   double flowTolerance = 1.0e-15; // Convergence tolerance for flow calculation (PageRank)
+  std::string flowAcceleration = "none"; // none | quadratic
+  std::string flowCacheDir; // --flow-cache <dir>
+  std::string initialFlowFile; // --initial-flow <file>
 
   // Clustering
   bool twoLevel = false;
@@ -151,7 +154,16 @@ struct Config {
   unsigned int fastHierarchicalSolution = 0;
   bool preferModularSolution = false;
   bool innerParallelization = false;
+  bool deterministic = false; // Thread-count-independent parallel optimization
+  std::string innerParallelStrategy = "proposals"; // proposals | coloring
+  bool activeSet = false; // Sweep only nodes whose neighbourhood changed
+  bool parallelFineTune = false; // Parallel fine-tune over the nodes near changed modules
+  bool exactSmallModules = false; // Partition modules of at most eight nodes exactly in the recursive phase
+  unsigned int partitionTaskGrain = 16; // Nodes per OpenMP task in the recursive partition
+  bool parallelSuperModules = false; // Super-module search with the parallel move sweep
   bool parallelTrials = false;
+  bool pruneTrials = false; // Abandon parallel trials that fall too far behind the best finished one
+  double pruneTrialsMargin = 0.02; // Relative codelength margin a trial may trail the best by
 #if INFOMAP_FEATURE_TEST_FEATURE
   bool testFeature = false;
 #endif
@@ -246,6 +258,8 @@ struct Config {
     maxFlowIterations = other.maxFlowIterations;
     minFlowIterations = other.minFlowIterations;
     flowTolerance = other.flowTolerance;
+    flowAcceleration = other.flowAcceleration;
+    flowCacheDir = other.flowCacheDir;
     twoLevel = other.twoLevel;
     noCoarseTune = other.noCoarseTune;
     recordedTeleportation = other.recordedTeleportation;
@@ -261,6 +275,15 @@ struct Config {
     minimumRelativeTuneIterationImprovement = other.minimumRelativeTuneIterationImprovement;
     preferModularSolution = other.preferModularSolution;
     innerParallelization = other.innerParallelization;
+    deterministic = other.deterministic;
+    innerParallelStrategy = other.innerParallelStrategy;
+    activeSet = other.activeSet;
+    parallelFineTune = other.parallelFineTune;
+    exactSmallModules = other.exactSmallModules;
+    partitionTaskGrain = other.partitionTaskGrain;
+    parallelSuperModules = other.parallelSuperModules;
+    pruneTrials = other.pruneTrials;
+    pruneTrialsMargin = other.pruneTrialsMargin;
 #if INFOMAP_FEATURE_TEST_FEATURE
     testFeature = other.testFeature;
 #endif
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ Infomap software package for multi-level network clustering
+ Copyright (c) 2013, 2014 Daniel Edler, Anton Holmgren, Martin Rosvall
+
+ This file is part of the Infomap software package.
+ See file LICENSE_GPLv3.txt for full license details.
+ For more information, see <http://www.mapequation.org>
+ ******************************************************************************/
+
+#include "FlowCache.h"
+#include "Config.h"
+#include "SafeFile.h"
+#include "../core/StateNetwork.h"
+#include "../utils/FlowCalculator.h"
+#include "../utils/format.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+namespace infomap {
+
+namespace {
+
+  // Bumped whenever the key or the file layout changes, so older files miss.
+  constexpr std::uint32_t flowCacheVersion = 1;
+  constexpr char flowCacheMagic[8] = { 'I', 'M', 'F', 'L', 'O', 'W', '\0', '\0' };
+  // Node values cached per state node, in StateNode field order.
+  constexpr std::size_t valuesPerNode = 7;
+
+  // FNV-1a, as the run metadata fingerprints use.
+  class KeyHash {
+  public:
+    template <typename T>
+    void add(const T& value)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "hash the bytes of plain values only");
+      addBytes(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void add(const std::vector<T>& values)
+    {
+      add(static_cast<std::uint64_t>(values.size()));
+      addBytes(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    void add(const std::string& value)
+    {
+      add(static_cast<std::uint64_t>(value.size()));
+      addBytes(value.data(), value.size());
+    }
+
+    unsigned long long value() const { return m_hash; }
+
+  private:
+    void addBytes(const char* data, std::size_t size)
+    {
+      for (std::size_t i = 0; i < size; ++i) {
+        m_hash ^= static_cast<unsigned char>(data[i]);
+        m_hash *= 1099511628211ull;
+      }
+    }
+
+    unsigned long long m_hash = 14695981039346656037ull;
+  };
+
+  template <typename T>
+  void writeValue(std::ostream& out, const T& value)
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  bool readValue(std::istream& in, T& value)
+  {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+  }
+
+  void writeString(std::ostream& out, const std::string& value)
+  {
+    writeValue(out, static_cast<std::uint64_t>(value.size()));
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+  }
+
+  bool readString(std::istream& in, std::string& value)
+  {
+    std::uint64_t size = 0;
+    // The strings are short report lines; anything longer is a damaged file.
+    if (!readValue(in, size) || size > 4096)
+      return false;
+    value.resize(static_cast<std::size_t>(size));
+    return static_cast<bool>(in.read(&value[0], static_cast<std::streamsize>(size)));
+  }
+
+  bool readDoubles(std::istream& in, std::vector<double>& values, std::size_t size)
+  {
+    values.resize(size);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(size * sizeof(double))));
+  }
+
+} // namespace
+
+FlowCache::FlowCache(const std::string& directory, const StateNetwork& network, const Config& config)
+{
+  network.ensureFinalized();
+
+  KeyHash hash;
+  hash.add(flowCacheVersion);
+
+  // Everything FlowCalculator reads from the network: the CSR links, the state
+  // nodes with the attributes the flow models use, and the input flags that pick
+  // between them.
+  hash.add(network.m_nodeIds);
+  hash.add(network.m_linkOffsets);
+  hash.add(network.m_linkTargets);
+  hash.add(network.m_linkWeights);
+  for (const auto& nodeIt : network.m_nodes) {
+    const auto& node = nodeIt.second;
+    hash.add(node.id);
+    hash.add(node.physicalId);
+    hash.add(node.layerId);
+    hash.add(node.weight);
+  }
+  for (const auto layer : network.m_layers)
+    hash.add(layer);
+  hash.add(network.numPhysicalNodes());
+  hash.add(network.sumLinkWeight());
+  hash.add(network.sumSelfLinkWeight());
+  hash.add(network.m_bipartiteStartId);
+  hash.add(network.haveMemoryInput());
+  hash.add(network.haveFileInput());
+  hash.add(network.haveNodeWeights());
+  hash.add(network.haveStateNodeWeights());
+  // A warm start moves the flow within the tolerance, so it is part of the key too.
+  hash.add(static_cast<std::uint64_t>(network.m_initialFlow.size()));
+  for (const auto& flow : network.m_initialFlow) {
+    hash.add(flow.first);
+    hash.add(flow.second);
+  }
+
+  // And every Config field it reads.
+  hash.add(config.flowModel.value);
+  hash.add(config.teleportationProbability);
+  hash.add(config.recordedTeleportation);
+  hash.add(config.teleportToNodes);
+  hash.add(config.regularized);
+  hash.add(config.regularizationStrength);
+  hash.add(config.maxFlowIterations);
+  hash.add(config.minFlowIterations);
+  hash.add(config.flowTolerance);
+  hash.add(config.flowAcceleration);
+  hash.add(config.bipartiteTeleportation);
+  hash.add(config.skipAdjustBipartiteFlow);
+  hash.add(config.useNodeWeightsAsFlow);
+  hash.add(config.noSelfLinks);
+  hash.add(config.multilayerRelaxToSelf);
+  hash.add(config.isMultilayerNetwork());
+
+  m_key = hash.value();
+  m_filename = fmt::format(FMT_STRING("{}/flow-{:016x}.bin"), stripTrailingPathSeparators(directory), m_key);
+}
+
+bool FlowCache::read(StateNetwork& network, detail::FlowReport& report) const
+{
+  std::ifstream in(m_filename, std::ios_base::binary);
+  if (!in)
+    return false;
+
+  char magic[sizeof(flowCacheMagic)];
+  std::uint32_t version = 0;
+  unsigned long long key = 0;
+  std::uint64_t numNodes = 0;
+  std::uint64_t numLinks = 0;
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, flowCacheMagic, sizeof(magic)) != 0)
+    return false;
+  if (!readValue(in, version) || version != flowCacheVersion || !readValue(in, key) || key != m_key)
+    return false;
+  if (!readValue(in, numNodes) || numNodes != network.m_nodes.size() || !readValue(in, numLinks) || numLinks != network.m_linkFlows.size())
+    return false;
+
+  std::uint8_t haveConvergence = 0;
+  std::uint8_t converged = 0;
+  std::uint32_t iterations = 0;
+  double error = 0.0;
+  if (!readValue(in, haveConvergence) || !readValue(in, converged) || !readValue(in, iterations) || !readValue(in, error))
+    return false;
+
+  detail::FlowReport cached;
+  std::uint64_t numNotes = 0;
+  if (!readString(in, cached.method) || !readString(in, cached.teleportation) || !readValue(in, numNotes) || numNotes > 64)
+    return false;
+  cached.notes.resize(static_cast<std::size_t>(numNotes));
+  for (auto& note : cached.notes) {
+    if (!readString(in, note))
+      return false;
+  }
+  if (!readValue(in, cached.sumNodeFlow) || !readValue(in, cached.sumLinkFlow))
+    return false;
+
+  // Read everything before touching the network, so a truncated file leaves it as it was.
+  std::vector<double> nodeValues;
+  std::vector<double> linkFlows;
+  if (!readDoubles(in, nodeValues, numNodes * valuesPerNode) || !readDoubles(in, linkFlows, numLinks))
+    return false;
+
+  auto value = nodeValues.begin();
+  for (auto& nodeIt : network.m_nodes) {
+    auto& node = nodeIt.second;
+    node.weight = *value++;
+    node.flow = *value++;
+    node.enterFlow = *value++;
+    node.exitFlow = *value++;
+    node.teleFlow = *value++;
+    node.intraLayerTeleFlow = *value++;
+    node.intraLayerTeleWeight = *value++;
+  }
+  network.m_linkFlows = std::move(linkFlows);
+  network.m_haveFlowConvergence = haveConvergence != 0;
+  network.m_flowConverged = converged != 0;
+  network.m_flowIterations = iterations;
+  network.m_flowError = error;
+  network.m_flowCacheFile = m_filename;
+  network.m_flowCacheHit = true;
+  report = std::move(cached);
+  return true;
+}
+
+void FlowCache::write(const StateNetwork& network, const detail::FlowReport& report) const
+{
+  const auto separator = m_filename.find_last_of("/\\");
+  if (separator != std::string::npos)
+    ensureDirectoryExists(m_filename.substr(0, separator));
+
+  SafeOutFile out(m_filename, std::ios_base::out | std::ios_base::binary);
+  out.write(flowCacheMagic, sizeof(flowCacheMagic));
+  writeValue(out, flowCacheVersion);
+  writeValue(out, m_key);
+  writeValue(out, static_cast<std::uint64_t>(network.m_nodes.size()));
+  writeValue(out, static_cast<std::uint64_t>(network.m_linkFlows.size()));
+
+  writeValue(out, static_cast<std::uint8_t>(network.m_haveFlowConvergence));
+  writeValue(out, static_cast<std::uint8_t>(network.m_flowConverged));
+  writeValue(out, static_cast<std::uint32_t>(network.m_flowIterations));
+  writeValue(out, network.m_flowError);
+  writeString(out, report.method);
+  writeString(out, report.teleportation);
+  writeValue(out, static_cast<std::uint64_t>(report.notes.size()));
+  for (const auto& note : report.notes)
+    writeString(out, note);
+  writeValue(out, report.sumNodeFlow);
+  writeValue(out, report.sumLinkFlow);
+
+  for (const auto& nodeIt : network.m_nodes) {
+    const auto& node = nodeIt.second;
+    for (const auto value : { node.weight, node.flow, node.enterFlow, node.exitFlow, node.teleFlow, node.intraLayerTeleFlow, node.intraLayerTeleWeight })
+      writeValue(out, value);
+  }
+  out.write(reinterpret_cast<const char*>(network.m_linkFlows.data()), static_cast<std::streamsize>(network.m_linkFlows.size() * sizeof(double)));
+
+  if (!out)
+    throw InfomapError(ExitCode::OutputError, fmt::format(FMT_STRING("Could not write flow cache '{}'."), m_filename));
+  out.commit();
+}
+
+} // namespace infomap
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ Infomap software package for multi-level network clustering
+ Copyright (c) 2013, 2014 Daniel Edler, Anton Holmgren, Martin Rosvall
+
+ This file is part of the Infomap software package.
+ See file LICENSE_GPLv3.txt for full license details.
+ For more information, see <http://www.mapequation.org>
+ ******************************************************************************/
+
+#ifndef FLOW_CACHE_H_
+#define FLOW_CACHE_H_
+
+#include <string>
+
+namespace infomap {
+
+struct Config;
+class StateNetwork;
+
+namespace detail {
+  struct FlowReport;
+} // namespace detail
+
+/**
+ * On-disk cache of the calculated flow, for --flow-cache. A file holds the node
+ * and link flows of one network under one set of flow settings, named by a
+ * content hash of the network's CSR links and node attributes and of the Config
+ * fields the flow calculation reads. Reruns that only change the optimization
+ * (seeds, Markov time, module preferences) find it and skip the power iteration.
+ *
+ * The file is raw native-endian data: a cache for one machine, not an exchange
+ * format. Anything unexpected in it is a miss.
+ */
+class FlowCache {
+public:
+  //! Hash the network and config. Call after finalizeLinks and before any flow is set.
+  FlowCache(const std::string& directory, const StateNetwork&, const Config&);
+
+  const std::string& filename() const { return m_filename; }
+
+  //! Restore the flow of a matching cache file into the network; false on a miss.
+  bool read(StateNetwork&, detail::FlowReport&) const;
+
+  //! Store the network's calculated flow. The file appears atomically.
+  void write(const StateNetwork&, const detail::FlowReport&) const;
+
+private:
+  unsigned long long m_key = 0;
+  std::string m_filename;
+};
+
+} // namespace infomap
+
+#endif // FLOW_CACHE_H_
@@ -122,6 +122,21 @@ void Network::readMetaData(const std::string& filename)
   }
 }
 
+void Network::readInitialFlow(const std::string& filename)
+{
+  ClusterMap clusterMap;
+  try {
+    clusterMap.readClusterData(filename, true, isMultilayerNetwork() ? &m_layerNodeToStateId : nullptr);
+  } catch (const InfomapError&) {
+    throw;
+  } catch (const std::exception& e) {
+    throw InfomapError(ExitCode::InputError, e.what());
+  }
+  if (clusterMap.flowData().empty())
+    throw InfomapError(ExitCode::InputError, fmt::format(FMT_STRING("No node flow in initial flow file '{}'. Use a clu file with a flow column, or a tree or ftree file."), filename));
+  setInitialFlow(clusterMap.flowData());
+}
+
 void Network::printSummary()
 {
   Console console;
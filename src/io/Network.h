@@ -93,6 +93,13 @@ public:
    */
   virtual void readMetaData(const std::string& filename);
 
+  /**
+   * Read the initial node flow for setInitialFlow from the flow column of a
+   * clu, tree or ftree file, such as the output of a run on a previous snapshot.
+   * @param filename input filename for the initial flow
+   */
+  virtual void readInitialFlow(const std::string& filename);
+
   unsigned int numMetaDataColumns() const { return m_numMetaDataColumns; }
   const std::map<unsigned int, std::vector<int>>& metaData() const override { return m_metaData; }
 
@@ -597,6 +597,29 @@ const std::vector<ParameterSpec>& parameterCatalog()
         .defaultValue("1e-15")
         .min("0")
         .configTarget(&Config::flowTolerance),
+    param()
+        .longName("flow-acceleration")
+        .description("Accelerate the power iteration used to calculate flow. 'none' runs plain power iteration. 'quadratic' extrapolates from the last four iterates every ten iterations (quadratic extrapolation), which saves the most with a low teleportation probability. The flow is the same within --flow-tolerance.")
+        .argument(ArgType::option)
+        .group("Algorithm")
+        .advanced()
+        .choices({ "none", "quadratic" })
+        .defaultValue("none")
+        .configTarget(&Config::flowAcceleration),
+    param()
+        .longName("flow-cache")
+        .description("Keep the calculated flow in this directory and reuse it when the same network is run again with the same flow settings, skipping the flow calculation. Files are named by a hash of the network and the flow settings.")
+        .argument(ArgType::path)
+        .group("Algorithm")
+        .advanced()
+        .configTarget(&Config::flowCacheDir),
+    param()
+        .longName("initial-flow")
+        .description("Start the power iteration used to calculate flow from the node flow in a clu, tree or ftree file, such as the output of a run on a previous snapshot of the network. If the file misses nodes, one power iteration from the degrees is taken first, counted in the iterations, and they keep its flow. Applies to directed flow, also with --regularized, but not with --bipartite-teleportation; lower --min-flow-iterations to let a close starting flow stop early.")
+        .argument(ArgType::path)
+        .group("Algorithm")
+        .advanced()
+        .configTarget(&Config::initialFlowFile),
     param()
         .longName("regularized")
         .description("Add a fully connected Bayesian prior network to reduce overfitting to missing links. Activates --recorded-teleportation.")
@@ -813,12 +836,74 @@ const std::vector<ParameterSpec>& parameterCatalog()
         .group("Accuracy")
         .advanced()
         .configTarget(&Config::innerParallelization),
+    param()
+        .longName("deterministic")
+        .description("Make parallel optimization independent of the thread count. With --inner-parallelization, large networks always use the parallel move sweep over fixed node blocks with per-block random streams derived from the seed, whatever --num-threads is, and parallel-trial workers keep it. The output is then identical for any --num-threads at a small throughput cost.")
+        .group("Accuracy")
+        .advanced()
+        .configTarget(&Config::deterministic),
+    param()
+        .longName("inner-parallel-strategy")
+        .description("Sweep engine for --inner-parallelization. 'proposals' proposes every move against the sweep-start modules and commits them serially, rechecking moves whose modules changed. Experimental: 'coloring' colors the network so no two linked nodes share a color and moves each color at once without a commit pass; it applies to ordinary networks without recorded teleportation, other objectives use 'proposals'. It has not yet been measured against 'proposals' on several threads, where skipping the commit pass is meant to pay off.")
+        .argument(ArgType::option)
+        .group("Accuracy")
+        .advanced()
+        .choices({ "proposals", "coloring" })
+        .defaultValue("proposals")
+        .configTarget(&Config::innerParallelStrategy),
+    param()
+        .longName("active-set")
+        .description("Keep a queue of the nodes whose neighbourhood changed and sweep only those, in random order, instead of scanning every node for a change in each core loop. Late core loops then cost in proportion to the nodes still moving. Nodes marked during a sweep wait for the next one, so the partition may differ from the default sweep. Applies to the serial and the 'proposals' parallel sweep.")
+        .group("Accuracy")
+        .advanced()
+        .configTarget(&Config::activeSet),
+    param()
+        .longName("parallel-fine-tune")
+        .description("Fine-tune with the parallel move sweep, also without --inner-parallelization, and revisit only the nodes in or linked to a module that changed since the previous fine-tune. Later tune iterations then cost in proportion to what the coarse tune and the merges changed. Follows --deterministic and --inner-parallel-strategy.")
+        .group("Accuracy")
+        .advanced()
+        .configTarget(&Config::parallelFineTune),
+    param()
+        .longName("exact-small-modules")
+        .description("In the recursive sub-module search, partition modules of three to eight nodes by trying every way to split them instead of running a sub-Infomap on each. The split with the shortest two-level codelength is kept if it passes the same test a sub-Infomap result would, so such modules always get their optimal split but no super-module level within them.")
+        .group("Accuracy")
+        .advanced()
+        .configTarget(&Config::exactSmallModules),
+    param()
+        .longName("partition-task-grain")
+        .description("Smallest number of nodes the recursive sub-module search hands to one OpenMP task. A module with at least this many nodes gets its own task, smaller ones are batched into one task until their nodes add up to it, and a remainder below it is searched by the task that found the modules. 0 gives every module its own task.")
+        .argument(ArgType::integer)
+        .group("Accuracy")
+        .advanced()
+        .defaultValue("16")
+        .configTarget(&Config::partitionTaskGrain),
+    param()
+        .longName("parallel-super-modules")
+        .description("Search for super-modules with the parallel move sweep, also without --inner-parallelization, on super networks large enough for the parallel sweep. Follows --deterministic and --inner-parallel-strategy.")
+        .group("Accuracy")
+        .advanced()
+        .configTarget(&Config::parallelSuperModules),
     param()
         .longName("parallel-trials")
-        .description("Run independent trials in parallel with OpenMP. --num-trials remains the total number of trials; the number of parallel workers follows the OpenMP thread count (e.g. OMP_NUM_THREADS), clamped to --num-trials. Peak memory scales with the worker count. Nested OpenMP and --inner-parallelization are disabled inside workers.")
+        .description("Run independent trials in parallel with OpenMP. --num-trials remains the total number of trials; the number of parallel workers follows the OpenMP thread count (e.g. OMP_NUM_THREADS), clamped to --num-trials. Peak memory scales with the worker count. The OpenMP threads are split evenly over the workers: a worker with more than one thread runs its trials on a nested team of them and keeps --inner-parallelization, and workers still running trials take over the threads of those that are done. With one thread per worker, nesting is off and --inner-parallelization runs single-threaded under --deterministic, or not at all.")
         .group("Accuracy")
         .advanced()
         .configTarget(&Config::parallelTrials),
+    param()
+        .longName("prune-trials")
+        .description("With --parallel-trials, abandon a trial whose codelength after the two-level partition is more than --prune-trials-margin above the best two-level codelength so far, or whose codelength after the super-module search is that far above the best finished trial. Abandoned trials are marked in --trial-results. Which trials are abandoned depends on the order they finish in.")
+        .group("Accuracy")
+        .advanced()
+        .configTarget(&Config::pruneTrials),
+    param()
+        .longName("prune-trials-margin")
+        .description("Relative codelength margin for --prune-trials: a trial is abandoned when its codelength exceeds the best at the same stage by more than this fraction.")
+        .argument(ArgType::number)
+        .group("Accuracy")
+        .advanced()
+        .defaultValue("0.02")
+        .min("0")
+        .configTarget(&Config::pruneTrialsMargin),
     param()
         .longName("converge")
         .description("Treat the trial count as a cap and stop early once the best codelength has plateaued (no meaningful improvement over several consecutive trials). Runs trials serially; cannot be combined with parallel trials or distributed sharding. With no explicit trial count, a default cap is used.")
@@ -127,6 +127,7 @@ std::string canonicalConfigJson(const Config& config)
   // same sequence of trials.
   //
   // Output-only settings are excluded because they cannot change the result.
+  // So is --flow-cache: a hit restores the flow the same settings would calculate.
   // That held for trialResultsPath only after #905: it used to switch the
   // per-trial reseeding on, which made two runs with the same fingerprint
   // publish different partitions.
@@ -171,8 +172,17 @@ std::string canonicalConfigJson(const Config& config)
   addCanonicalNumber(json, "preferred_number_of_levels", config.preferredNumberOfLevels);
   addCanonicalNumber(json, "preferred_number_of_levels_strength", config.preferredNumberOfLevelsStrength);
   json["parallel_trials"] = config.parallelTrials;
+  json["prune_trials"] = config.pruneTrials;
+  addCanonicalNumber(json, "prune_trials_margin", config.pruneTrialsMargin);
   json["converge_trials"] = config.convergeTrials;
   json["inner_parallelization"] = config.innerParallelization;
+  json["deterministic"] = config.deterministic;
+  json["inner_parallel_strategy"] = config.innerParallelStrategy;
+  json["active_set"] = config.activeSet;
+  json["parallel_fine_tune"] = config.parallelFineTune;
+  json["exact_small_modules"] = config.exactSmallModules;
+  addCanonicalNumber(json, "partition_task_grain", config.partitionTaskGrain);
+  json["parallel_super_modules"] = config.parallelSuperModules;
   addCanonicalNumber(json, "core_loop_limit", config.coreLoopLimit);
   addCanonicalNumber(json, "core_level_limit", config.levelAggregationLimit);
   addCanonicalNumber(json, "tune_iteration_limit", config.tuneIterationLimit);
@@ -181,6 +191,8 @@ std::string canonicalConfigJson(const Config& config)
   addCanonicalNumber(json, "max_flow_iterations", config.maxFlowIterations);
   addCanonicalNumber(json, "min_flow_iterations", config.minFlowIterations);
   addCanonicalNumber(json, "flow_tolerance", config.flowTolerance);
+  json["flow_acceleration"] = config.flowAcceleration;
+  json["initial_flow"] = config.initialFlowFile;
   json["prefer_modular_solution"] = config.preferModularSolution;
   addCanonicalNumber(json, "num_random_moves", config.numRandomMoves);
   addCanonicalNumber(json, "max_degree_for_random_moves", config.maxDegreeForRandomMoves);
@@ -46,6 +46,12 @@ std::string runSummaryReportJson(const RunSummaryReport& report)
     flow["error"] = report.flowError;
     json["flow"] = std::move(flow);
   }
+  if (!report.flowCacheFile.empty()) {
+    Json flowCache;
+    flowCache["file"] = report.flowCacheFile;
+    flowCache["hit"] = report.flowCacheHit;
+    json["flow_cache"] = std::move(flowCache);
+  }
   json["trial_codelengths"] = report.trialCodelengths;
   json["trial_top_modules"] = report.trialTopModules;
   return dumpJsonLine(json);
@@ -89,6 +95,17 @@ std::string runTimingReportJson(const RunTimingReport& report)
   }
   json["trials"] = std::move(trials);
 
+  Json subInfomaps;
+  subInfomaps["instances"] = report.subInfomaps;
+  subInfomaps["reused"] = report.subInfomapsReused;
+  subInfomaps["allocated"] = report.subInfomaps - report.subInfomapsReused;
+  json["sub_infomaps"] = std::move(subInfomaps);
+
+  Json partitionTasks;
+  partitionTasks["created"] = report.partitionTasksCreated;
+  partitionTasks["executed"] = report.partitionTasksExecuted;
+  json["partition_tasks"] = std::move(partitionTasks);
+
   if (report.includeMemory) {
     Json memory;
     memory["rss_peak_mb"] = report.memory.rssPeakMb;
@@ -40,6 +40,9 @@ struct RunSummaryReport {
   bool flowConverged = true;
   unsigned int flowIterations = 0;
   double flowError = 0.0;
+  // --flow-cache file, and whether the flow came from it; emitted only with --flow-cache.
+  std::string flowCacheFile;
+  bool flowCacheHit = false;
   std::vector<double> trialCodelengths;
   std::vector<unsigned int> trialTopModules;
 };
@@ -53,6 +56,13 @@ struct RunTimingReport {
   RunReportNetwork network;
   std::vector<std::pair<std::string, double>> timing;
   std::vector<TrialTimingRecord> trials;
+  // Sub-Infomap instances the run created, and how many of those were recycled
+  // from a thread's pool rather than allocated.
+  unsigned long long subInfomaps = 0;
+  unsigned long long subInfomapsReused = 0;
+  // OpenMP tasks the recursive partition created, and how many of them ran.
+  unsigned long long partitionTasksCreated = 0;
+  unsigned long long partitionTasksExecuted = 0;
   bool includeMemory = false;
   MemoryReport memory;
 };
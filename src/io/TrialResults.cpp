@@ -48,6 +48,7 @@ std::string serializeTrialResults(const TrialResultsFile& r)
     trial["num_levels"] = t.numLevels;
     trial["thread"] = t.thread;
     trial["time_s"] = t.timeSec;
+    trial["abandoned"] = t.abandoned;
     trials.push_back(std::move(trial));
   }
   json["trials"] = std::move(trials);
@@ -23,6 +23,7 @@ struct TrialResultEntry {
   unsigned int numLevels = 0;
   int thread = 0;
   double timeSec = 0.0;
+  bool abandoned = false; // stopped early by --prune-trials; codelength is where it stopped
 };
 
 struct TrialResultsFile {
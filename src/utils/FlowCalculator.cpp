@@ -14,6 +14,7 @@
 #include "../utils/format.h"
 #include "../utils/infomath.h"
 #include "../core/StateNetwork.h"
+#include "../io/FlowCache.h"
 #include "../io/InfomapError.h"
 #include <cmath>
 #include <numeric>
@@ -45,6 +46,243 @@ namespace {
     return err <= config.flowTolerance;
   }
 
+  // The links of a range of flowLinks grouped by target, in link order within
+  // each target, with the source and the link flow in separate contiguous arrays.
+  // The power iterations pull a node's new flow from its in-links, so the nodes
+  // update in parallel without write conflicts, and each node still adds its
+  // in-flows in the order the scatter over flowLinks did.
+  struct InLinks {
+    std::vector<std::size_t> offsets;
+    std::vector<unsigned int> sources;
+    std::vector<double> flows;
+  };
+
+  // Group the links in [first, last) that `keep` accepts (by flowLinks index).
+  // Taken after the link weights are normalized to transition probabilities.
+  template <typename Keep>
+  InLinks groupByTarget(const detail::FlowLinks& links, unsigned int numNodes, std::size_t first, std::size_t last, Keep&& keep)
+  {
+    InLinks in;
+    in.offsets.assign(numNodes + 1, 0);
+    for (auto k = first; k < last; ++k) {
+      if (keep(k))
+        ++in.offsets[links.target[k] + 1];
+    }
+    for (unsigned int i = 0; i < numNodes; ++i)
+      in.offsets[i + 1] += in.offsets[i];
+    in.sources.resize(in.offsets[numNodes]);
+    in.flows.resize(in.offsets[numNodes]);
+    std::vector<std::size_t> next(in.offsets.begin(), in.offsets.end() - 1);
+    for (auto k = first; k < last; ++k) {
+      if (!keep(k))
+        continue;
+      const auto pos = next[links.target[k]]++;
+      in.sources[pos] = links.source[k];
+      in.flows[pos] = links.flow[k];
+    }
+    return in;
+  }
+
+  InLinks groupByTarget(const detail::FlowLinks& links, unsigned int numNodes, std::size_t first, std::size_t last)
+  {
+    return groupByTarget(links, numNodes, first, last, [](std::size_t) { return true; });
+  }
+
+  // `flow` plus scale * P(source -> node) * src[source] over the in-links of node,
+  // term for term as the scatter over flowLinks computed it.
+  inline double pullFlow(const InLinks& in, unsigned int node, double scale, const std::vector<double>& src, double flow)
+  {
+    for (auto k = in.offsets[node]; k < in.offsets[node + 1]; ++k)
+      flow += scale * in.flows[k] * src[in.sources[k]];
+    return flow;
+  }
+
+  // Nodes per block of a parallel power iteration. Fixed rather than derived
+  // from the team size, so the per-block partial sums, and the totals added up
+  // from them, are the same for any number of threads.
+  constexpr unsigned int flowBlockSize = 1u << 14;
+
+  inline unsigned int numFlowBlocks(unsigned int begin, unsigned int end)
+  {
+    return end > begin ? (end - begin + flowBlockSize - 1) / flowBlockSize : 0;
+  }
+
+  // Run body(i) for every node in [begin, end), spread over the threads in blocks.
+  template <typename Body>
+  void forEachNode(unsigned int begin, unsigned int end, Body&& body)
+  {
+    const auto numBlocks = static_cast<int>(numFlowBlocks(begin, end));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (numBlocks > 1)
+#endif
+    for (int block = 0; block < numBlocks; ++block) {
+      const auto blockBegin = begin + static_cast<unsigned int>(block) * flowBlockSize;
+      const auto blockEnd = std::min(end, blockBegin + flowBlockSize);
+      for (auto i = blockBegin; i < blockEnd; ++i)
+        body(i);
+    }
+  }
+
+  struct FlowSums {
+    double first = 0.0;
+    double second = 0.0;
+  };
+
+  // Like forEachNode, with body(i, sums) adding to two sums. Each block sums
+  // its own nodes and the block sums are added in block order -- in place of an
+  // OpenMP reduction, whose order would follow the team size. The first block
+  // starts from `init`, so within one block this is exactly the serial loop.
+  template <typename Body>
+  FlowSums sumOverNodes(unsigned int begin, unsigned int end, FlowSums init, Body&& body)
+  {
+    const auto numBlocks = static_cast<int>(numFlowBlocks(begin, end));
+    if (numBlocks == 0)
+      return init;
+    std::vector<FlowSums> blockSums(numBlocks);
+    blockSums[0] = init;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (numBlocks > 1)
+#endif
+    for (int block = 0; block < numBlocks; ++block) {
+      const auto blockBegin = begin + static_cast<unsigned int>(block) * flowBlockSize;
+      const auto blockEnd = std::min(end, blockBegin + flowBlockSize);
+      auto sums = blockSums[block];
+      for (auto i = blockBegin; i < blockEnd; ++i)
+        body(i, sums);
+      blockSums[block] = sums;
+    }
+    auto total = blockSums[0];
+    for (int block = 1; block < numBlocks; ++block) {
+      total.first += blockSums[block].first;
+      total.second += blockSums[block].second;
+    }
+    return total;
+  }
+
+  // Every link's flow scaled by a factor of its source node, spread over the threads.
+  template <typename Factor>
+  void scaleLinkFlows(detail::FlowLinks& links, Factor&& factor)
+  {
+    const auto numLinks = static_cast<std::ptrdiff_t>(links.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (numLinks > static_cast<std::ptrdiff_t>(flowBlockSize))
+#endif
+    for (std::ptrdiff_t k = 0; k < numLinks; ++k) {
+      links.flow[k] *= factor(links.source[k]);
+    }
+  }
+
+  // Quadratic extrapolation (Kamvar et al. 2003) of the power iterates, for
+  // --flow-acceleration quadratic. Plain power iteration shrinks the error by
+  // about 1 - alpha per sweep, so with little teleportation it needs hundreds of
+  // sweeps. Every extrapolationPeriod iterations the last four iterates are
+  // combined to cancel the error along the next two eigenvectors. The result only
+  // seeds the next iteration, which measures the error as usual, so the
+  // convergence test and the final (unrecorded) step see plain iterates and the
+  // stationary flow is the same within --flow-tolerance.
+  class FlowExtrapolation {
+  public:
+    static constexpr unsigned int extrapolationPeriod = 10;
+    static constexpr unsigned int historySize = 3;
+
+    FlowExtrapolation(const std::string& method, unsigned int numNodes)
+        : m_enabled(method == "quadratic"), m_history(m_enabled ? historySize : 0, std::vector<double>(numNodes, 0.0)) { }
+
+    unsigned int numExtrapolations() const noexcept { return m_numExtrapolations; }
+
+    // Keep the three iterates the next extrapolation combines with the newest one.
+    void record(const std::vector<double>& flow, double error)
+    {
+      if (!m_enabled)
+        return;
+      m_lastError = error;
+      ++m_numPlainIterations;
+      if (m_numPlainIterations + historySize >= extrapolationPeriod && m_numPlainIterations < extrapolationPeriod)
+        m_history[m_numPlainIterations + historySize - extrapolationPeriod] = flow;
+    }
+
+    // Replace flow by the extrapolation once a period of plain iterations is done.
+    void extrapolateIfDue(std::vector<double>& flow)
+    {
+      if (!m_enabled || m_numPlainIterations < extrapolationPeriod)
+        return;
+      m_numPlainIterations = 0;
+      // A period that ends with no less error than the one before has left the
+      // regime the extrapolation models (a periodic chain, say); plain iteration
+      // takes it from there.
+      if (m_numExtrapolations > 0 && !(m_lastError < m_errorAtLastExtrapolation)) {
+        m_enabled = false;
+        return;
+      }
+      m_errorAtLastExtrapolation = m_lastError;
+      const auto numNodes = static_cast<unsigned int>(flow.size());
+      m_extrapolated.resize(numNodes);
+      if (!quadratic(flow))
+        return;
+
+      // Clip what overshot below zero and renormalize to a distribution.
+      const auto sum = sumOverNodes(0, numNodes, {}, [&](unsigned int i, FlowSums& sums) {
+        m_extrapolated[i] = std::max(m_extrapolated[i], 0.0);
+        sums.first += m_extrapolated[i];
+      }).first;
+      if (!(sum > 0.0) || !std::isfinite(sum))
+        return;
+      forEachNode(0, numNodes, [&](unsigned int i) { flow[i] = m_extrapolated[i] / sum; });
+      ++m_numExtrapolations;
+    }
+
+  private:
+    bool quadratic(const std::vector<double>& flow)
+    {
+      // y1, y2, y3 are the last three iterates minus the one before them. Solve the
+      // least-squares problem [y1 y2] g = -y3 through its 2x2 normal equations.
+      const auto numNodes = static_cast<unsigned int>(flow.size());
+      const auto& x0 = m_history[0];
+      const auto& x1 = m_history[1];
+      const auto& x2 = m_history[2];
+      const auto g11g22 = sumOverNodes(0, numNodes, {}, [&](unsigned int i, FlowSums& sums) {
+        const auto y1 = x1[i] - x0[i];
+        const auto y2 = x2[i] - x0[i];
+        sums.first += y1 * y1;
+        sums.second += y2 * y2;
+      });
+      const auto g12b1 = sumOverNodes(0, numNodes, {}, [&](unsigned int i, FlowSums& sums) {
+        const auto y1 = x1[i] - x0[i];
+        sums.first += y1 * (x2[i] - x0[i]);
+        sums.second += y1 * (flow[i] - x0[i]);
+      });
+      const auto b2 = sumOverNodes(0, numNodes, {}, [&](unsigned int i, FlowSums& sums) {
+        sums.first += (x2[i] - x0[i]) * (flow[i] - x0[i]);
+      }).first;
+
+      const auto g11 = g11g22.first;
+      const auto g22 = g11g22.second;
+      const auto g12 = g12b1.first;
+      const auto b1 = g12b1.second;
+      const auto det = g11 * g22 - g12 * g12;
+      // Collinear differences leave nothing to extrapolate.
+      if (!(det > 1e-10 * g11 * g22))
+        return false;
+      const auto gamma1 = -(g22 * b1 - g12 * b2) / det;
+      const auto gamma2 = -(g11 * b2 - g12 * b1) / det;
+      const auto beta0 = gamma1 + gamma2 + 1.0;
+      const auto beta1 = gamma2 + 1.0;
+      forEachNode(0, numNodes, [&](unsigned int i) {
+        m_extrapolated[i] = beta0 * x1[i] + beta1 * x2[i] + flow[i];
+      });
+      return true;
+    }
+
+    bool m_enabled;
+    unsigned int m_numPlainIterations = 0;
+    unsigned int m_numExtrapolations = 0;
+    double m_lastError = 0.0;
+    double m_errorAtLastExtrapolation = 0.0;
+    //! The iterates before the newest, oldest first; empty when disabled.
+    std::vector<std::vector<double>> m_history;
+    std::vector<double> m_extrapolated;
+  };
+
 } // namespace
 
 template <typename T>
@@ -73,101 +311,66 @@ FlowCalculator::FlowCalculator(StateNetwork& network, const Config& config)
     : numNodes(network.numNodes())
 {
   // Prepare data in sequence containers for fast access of individual elements
-  // Map to zero-based dense indexing
-  nodeIndexMap.reserve(numNodes);
   nodeFlow.assign(numNodes, 0.0);
   nodeTeleportWeights.assign(numNodes, 0.0); // Fraction of teleportation flow landing on node i
 
   nodeOutDegree.assign(numNodes, 0);
   sumLinkOutWeight.assign(numNodes, 0.0);
 
-  unsigned int nodeIndex = 0;
   network.ensureFinalized(); // CSR is the consumed link store; build it if needed
 
-  if (network.isBipartite()) {
-    // Preserve node order
-    for (const auto& node : network.nodes()) {
-      const auto nodeId = node.second.id;
-      nodeIndexMap[nodeId] = nodeIndex++;
+  // The CSR index is already a zero-based dense index, in node id order, so the
+  // internal index is read off it directly.
+  csrNodeIndex.resize(numNodes);
+  if (config.flowModel == FlowModel::directed && !network.isBipartite()) {
+    // Store dangling nodes out-of-order,
+    // with dangling nodes first to optimize calculation of dangling rank
+    unsigned int nodeIndex = 0;
+    for (unsigned int i = 0; i < numNodes; ++i) {
+      if (network.isDangling(i))
+        csrNodeIndex[i] = nodeIndex++;
     }
 
-    auto bipartiteStartId = network.bipartiteStartId();
-    bipartiteStartIndex = nodeIndexMap[bipartiteStartId];
+    nonDanglingStartIndex = nodeIndex;
 
-  } else {
-    if (config.flowModel != FlowModel::directed) {
-      // Preserve node order
-      for (const auto& node : network.nodes()) {
-        const auto nodeId = node.second.id;
-        nodeIndexMap[nodeId] = nodeIndex++;
-      }
-    } else {
-      // Store dangling nodes out-of-order,
-      // with dangling nodes first to optimize calculation of dangling rank
-
-      for (const auto& node : network.nodes()) {
-        const auto isDangling = network.isDangling(network.indexOfId(node.second.id));
-        if (!isDangling) continue;
-
-        const auto& nodeId = node.second.id;
-        nodeIndexMap[nodeId] = nodeIndex++;
-      }
-
-      nonDanglingStartIndex = nodeIndex;
-
-      for (const auto& node : network.nodes()) {
-        const auto isDangling = network.isDangling(network.indexOfId(node.second.id));
-        if (isDangling) continue;
-
-        const auto& nodeId = node.second.id;
-        nodeIndexMap[nodeId] = nodeIndex++;
-      }
+    for (unsigned int i = 0; i < numNodes; ++i) {
+      if (!network.isDangling(i))
+        csrNodeIndex[i] = nodeIndex++;
     }
+  } else {
+    // Preserve node order
+    std::iota(begin(csrNodeIndex), end(csrNodeIndex), 0u);
   }
 
-  flowLinks.resize(network.numLinks(), { 0, 0, 0.0 });
+  flowLinks.resize(network.numLinks());
   sumLinkWeight = network.sumLinkWeight();
   sumWeightedDegree = network.sumWeightedDegree();
 
   if (network.isBipartite()) {
-    const auto bipartiteStartId = network.bipartiteStartId();
-
-    for (unsigned int s = 0; s < numNodes; ++s) {
-      const auto sourceIsFeature = network.nodeId(s) >= bipartiteStartId;
-      if (sourceIsFeature) continue;
-      bipartiteLinkStartIndex += network.outDegree(s);
-    }
+    // The feature nodes are those from the start id on, so in CSR order they and
+    // their out-links follow the primary nodes and theirs.
+    bipartiteStartIndex = network.indexOfId(network.bipartiteStartId());
+    bipartiteLinkStartIndex = network.m_linkOffsets[bipartiteStartIndex];
   }
 
   unsigned int linkIndex = 0;
-  unsigned int featureLinkIndex = bipartiteLinkStartIndex; // bipartite case
   double undirectedLinkNormalization = 2 * sumLinkWeight - network.sumSelfLinkWeight();
 
   // CSR iterates links in (source, target) id order, identical to the nested
-  // map, so flowLinks indices match. Translate CSR index -> id -> FlowCalculator
-  // internal index (the directed model reorders dangling nodes first).
+  // map, so flowLinks indices match. The directed model's dangling-first
+  // ordering only moves nodes without links, so flowLinks stays in source order.
   network.forEachLink([&](unsigned int srcIdx, unsigned int tgtIdx, double linkWeight, double&) {
-    const auto sourceId = network.nodeId(srcIdx);
-    const auto sourceIndex = nodeIndexMap[sourceId];
-    const auto targetIndex = nodeIndexMap[network.nodeId(tgtIdx)];
+    const auto sourceIndex = csrNodeIndex[srcIdx];
+    const auto targetIndex = csrNodeIndex[tgtIdx];
 
     ++nodeOutDegree[sourceIndex];
     sumLinkOutWeight[sourceIndex] += linkWeight;
     nodeFlow[sourceIndex] += linkWeight / undirectedLinkNormalization;
 
-    if (network.isBipartite() && sourceId >= network.bipartiteStartId()) {
-      // Link from feature node to ordinary node
-      flowLinks[featureLinkIndex].source = sourceIndex;
-      flowLinks[featureLinkIndex].target = targetIndex;
-      flowLinks[featureLinkIndex].flow = linkWeight;
-      ++featureLinkIndex;
-    } else {
-      // Ordinary link, or unipartite
-      flowLinks[linkIndex].source = sourceIndex;
-      flowLinks[linkIndex].target = targetIndex;
-      flowLinks[linkIndex].flow = linkWeight;
-      ++linkIndex;
-    }
+    flowLinks.source[linkIndex] = sourceIndex;
+    flowLinks.target[linkIndex] = targetIndex;
+    flowLinks.flow[linkIndex] = linkWeight;
+    ++linkIndex;
 
     if (sourceIndex != targetIndex) {
       if (config.isUndirectedFlow()) {
@@ -264,77 +467,143 @@ FlowCalculator::FlowCalculator(StateNetwork& network, const Config& config)
     break;
   }
 
+  if (!network.initialFlow().empty() && !m_usedInitialFlow)
+    addFlowNote("Initial flow not used, this flow model has no power iteration to start");
+
   finalize(network, config, normalizeNodeFlow);
 }
 
 void FlowCalculator::addFlowNote(const std::string& note)
 {
-  m_flowNotes.push_back(note);
+  m_report.notes.push_back(note);
 }
 
 void FlowCalculator::recordPageRank(unsigned int iterations, double error, bool converged) noexcept
 {
   m_havePageRank = true;
-  m_pageRankIterations = iterations;
+  m_pageRankIterations = iterations + m_warmStartColdSteps;
   m_pageRankError = error;
   m_pageRankConverged = converged;
 }
 
+void FlowCalculator::recordExtrapolations(const Config& config, unsigned int extrapolations)
+{
+  if (config.flowAcceleration == "quadratic")
+    addFlowNote(fmt::format(FMT_STRING("Quadratic extrapolation applied {} times"), extrapolations));
+}
+
+template <typename ColdStep>
+double FlowCalculator::warmStart(const StateNetwork& network, ColdStep&& coldStep)
+{
+  const auto& initialFlow = network.initialFlow();
+  if (initialFlow.empty())
+    return 0.0;
+  m_usedInitialFlow = true;
+
+  std::vector<std::pair<unsigned int, double>> startFlow;
+  for (const auto& flow : initialFlow) {
+    // indexOfId gives where an unknown id would go, so check that it is there.
+    const auto csrIndex = network.indexOfId(flow.first);
+    if (csrIndex == numNodes || network.nodeId(csrIndex) != flow.first || !std::isfinite(flow.second) || flow.second < 0.0)
+      continue;
+    startFlow.emplace_back(csrNodeIndex[csrIndex], flow.second);
+  }
+  if (startFlow.empty()) {
+    addFlowNote("Initial flow matches no node, starting from the degrees");
+    return 0.0;
+  }
+  m_warmStartNodes = static_cast<unsigned int>(startFlow.size());
+
+  // With nodes missing from the initial flow, take the first step of a cold
+  // start for them to keep, which the report also compares the warm start with.
+  // It counts as a power iteration.
+  double coldError = 0.0;
+  if (m_warmStartNodes < numNodes) {
+    coldError = coldStep();
+    m_warmStartColdSteps = 1;
+  }
+  for (const auto& flow : startFlow)
+    nodeFlow[flow.first] = flow.second;
+  normalize(nodeFlow);
+  return coldError;
+}
+
+void FlowCalculator::recordWarmStart(const Config& config, double coldError, const std::vector<double>& errors)
+{
+  if (m_warmStartNodes == 0 || errors.empty())
+    return;
+  // What the warm start saves is in how much closer to the fixed point it begins:
+  // the first step's error against the cold start's. How many iterations that is
+  // depends on which modes the difference is in, which is why no count is guessed
+  // here -- a cold start's PageRank line gives the actual reduction.
+  const auto tolerance = std::find_if(errors.begin(), errors.end(), [&](double error) { return errorWithinFlowTolerance(config, error); });
+  const auto toleranceNote = tolerance == errors.end()
+      ? std::string("tolerance not reached")
+      : fmt::format(FMT_STRING("tolerance reached after {} iterations"), tolerance - errors.begin() + 1 + m_warmStartColdSteps);
+  if (m_warmStartColdSteps == 0) {
+    addFlowNote(fmt::format(FMT_STRING("Warm start from the initial flow of all {} nodes: first error {}, {}"),
+                            numNodes, io::toPrecision(errors.front(), 3), toleranceNote));
+    return;
+  }
+  addFlowNote(fmt::format(FMT_STRING("Warm start from the initial flow of {} of {} nodes: first error {} against {} from the degrees, {}"),
+                          m_warmStartNodes, numNodes, io::toPrecision(errors.front(), 3), io::toPrecision(coldError, 3), toleranceNote));
+}
+
 void FlowCalculator::calcUndirectedFlow() noexcept
 {
-  m_flowMethod = "undirected links";
+  m_report.method = "undirected links";
 
   // Flow is outgoing transition probability times source node flow
   // = w_ij / s_ij * s_ij / sum(s_ij) = w_ij / sum(s_ij)
   // Count twice for non-loops to cover flow in both directions
   // Assuming convention to treat self-links as directed
 
-  for (auto& link : flowLinks) {
-    link.flow /= sumWeightedDegree;
-    if (link.source != link.target) {
-      link.flow *= 2;
+  flowLinks.forEach([&](unsigned int source, unsigned int target, double& flow) {
+    flow /= sumWeightedDegree;
+    if (source != target) {
+      flow *= 2;
     }
-  }
+  });
 }
 
 void FlowCalculator::calcDirdirFlow(const Config& config) noexcept
 {
-  m_flowMethod = config.flowModel == FlowModel::outdirdir ? "ingoing links only" : "undirected links, directed steady state";
+  m_report.method = config.flowModel == FlowModel::outdirdir ? "ingoing links only" : "undirected links, directed steady state";
 
   // Take one last power iteration
   const std::vector<double> nodeFlowSteadyState(nodeFlow);
   nodeFlow.assign(numNodes, 0.0);
 
-  for (const auto& link : flowLinks) {
-    nodeFlow[link.target] += nodeFlowSteadyState[link.source] * link.flow / sumLinkOutWeight[link.source];
-  }
+  flowLinks.forEach([&](unsigned int source, unsigned int target, double flow) {
+    nodeFlow[target] += nodeFlowSteadyState[source] * flow / sumLinkOutWeight[source];
+  });
 
   double sumNodeFlow = std::accumulate(cbegin(nodeFlow), cend(nodeFlow), 0.0);
 
   // Update link data to represent flow instead of weight
-  for (auto& link : flowLinks) {
-    link.flow *= nodeFlowSteadyState[link.source] / sumLinkOutWeight[link.source] / sumNodeFlow;
-  }
+  flowLinks.forEach([&](unsigned int source, unsigned int, double& flow) {
+    flow *= nodeFlowSteadyState[source] / sumLinkOutWeight[source] / sumNodeFlow;
+  });
 }
 
 void FlowCalculator::calcRawdirFlow() noexcept
 {
-  m_flowMethod = "directed links with raw flow";
+  m_report.method = "directed links with raw flow";
   addFlowNote(fmt::format(FMT_STRING("Total link weight {:g}"), sumLinkWeight));
 
   // Treat the link weights as flow (after global normalization) and
   // do one power iteration to set the node flow
   nodeFlow.assign(numNodes, 0.0);
 
-  for (auto& link : flowLinks) {
-    link.flow /= sumLinkWeight;
-    nodeFlow[link.target] += link.flow;
-  }
+  flowLinks.forEach([&](unsigned int, unsigned int target, double& flow) {
+    flow /= sumLinkWeight;
+    nodeFlow[target] += flow;
+  });
 }
 
 void FlowCalculator::usePrecomputedFlow(const StateNetwork& network, const Config&)
 {
-  m_flowMethod = "precomputed directed flow";
+  m_report.method = "precomputed directed flow";
   addFlowNote(fmt::format(FMT_STRING("Total link flow {:g}"), sumLinkWeight));
 
   if (network.haveFileInput()) {
@@ -350,9 +619,11 @@ void FlowCalculator::usePrecomputedFlow(const StateNetwork& network, const Confi
   nodeFlow.assign(numNodes, 0.0);
   double sumFlow = 0.0;
 
+  // The nodes are in CSR order.
+  unsigned int csrIndex = 0;
   for (const auto& nodeIt : network.nodes()) {
     auto& node = nodeIt.second;
-    nodeFlow[nodeIndexMap[node.id]] = node.weight;
+    nodeFlow[csrNodeIndex[csrIndex++]] = node.weight;
     sumFlow += node.weight;
   }
   addFlowNote(fmt::format(FMT_STRING("Total node flow {:g}"), sumFlow));
@@ -380,18 +651,25 @@ struct IterationResult {
   unsigned int iterations;
   double error;
   bool converged;
+  unsigned int extrapolations;
+  std::vector<double> errors;
 };
 
 template <typename Iteration>
-IterationResult powerIterate(const Config& config, double alpha, Iteration&& iter)
+IterationResult powerIterate(const Config& config, double alpha, std::vector<double>& flow, Iteration&& iter)
 {
   unsigned int iterations = 0;
   double beta = 1.0 - alpha;
   double err = 0.0;
+  FlowExtrapolation extrapolation(config.flowAcceleration, static_cast<unsigned int>(flow.size()));
+  std::vector<double> errors;
 
   do {
+    extrapolation.extrapolateIfDue(flow);
     double oldErr = err;
     err = iter(iterations, alpha, beta);
+    extrapolation.record(flow, err);
+    errors.push_back(err);
 
     // Perturb the system if equilibrium
     if (std::abs(err - oldErr) < 1e-17) {
@@ -408,10 +686,15 @@ IterationResult powerIterate(const Config& config, double alpha, Iteration&& ite
     Console::warn(0, "PageRank calculation did not converge after {} iterations with error {:g}.", iterations, err);
   }
 
-  return { alpha, beta, iterations, err, converged };
+  return { alpha, beta, iterations, err, converged, extrapolation.numExtrapolations(), std::move(errors) };
 }
 
 double FlowCalculator::accumulateDanglingRank() const noexcept
+{
+  return sumOverDanglingNodes(nodeFlow);
+}
+
+double FlowCalculator::sumOverDanglingNodes(const std::vector<double>& values) const noexcept
 {
   // Two ways of locating the dangling nodes, one fast and one general. The directed
   // model orders them first, making their flow a prefix; bipartite input cannot use
@@ -419,28 +702,44 @@ double FlowCalculator::accumulateDanglingRank() const noexcept
   // the prefix form applies -- including the case of no dangling nodes at all, where
   // both forms sum to zero.
   if (danglingIndices.empty()) {
-    return std::accumulate(cbegin(nodeFlow), cbegin(nodeFlow) + nonDanglingStartIndex, 0.0);
+    return sumOverNodes(0, nonDanglingStartIndex, {}, [&values](unsigned int i, FlowSums& sum) { sum.first += values[i]; }).first;
   }
 
-  double sum = 0.0;
-  for (const auto i : danglingIndices) {
-    sum += nodeFlow[i];
-  }
-  return sum;
+  const auto numDangling = static_cast<unsigned int>(danglingIndices.size());
+  return sumOverNodes(0, numDangling, {}, [&](unsigned int k, FlowSums& sum) { sum.first += values[danglingIndices[k]]; }).first;
+}
+
+void FlowCalculator::addUnrecordedTeleportation(double alpha) noexcept
+{
+  // With unrecorded teleportation, the node flow Infomap reports -- and so an initial
+  // flow taken from an earlier run -- is one step of the walk past the PageRank vector
+  // that the power iteration converges to, taken without teleporting: f = P'pi / (1 - d),
+  // with d the dangling rank. Invert that step, pi = (alpha + beta d) v + beta (1 - d) f,
+  // solving for d over the dangling nodes, or the warm start begins a teleportation's
+  // worth of flow away from the fixed point.
+  const auto beta = 1.0 - alpha;
+  const auto danglingFlow = accumulateDanglingRank();
+  const auto danglingTeleportWeight = sumOverDanglingNodes(nodeTeleportWeights);
+  const auto danglingRank = (alpha * danglingTeleportWeight + beta * danglingFlow) / (1.0 - beta * danglingTeleportWeight + beta * danglingFlow);
+  forEachNode(0, numNodes, [&](unsigned int i) {
+    nodeFlow[i] = (alpha + beta * danglingRank) * nodeTeleportWeights[i] + beta * (1.0 - danglingRank) * nodeFlow[i];
+  });
 }
 
 void FlowCalculator::calcDirectedFlow(const StateNetwork& network, const Config& config) noexcept
 {
-  m_flowMethod = "directed links";
-  m_teleportation = fmt::format(FMT_STRING("{}, to {}"), config.recordedTeleportation ? "recorded" : "unrecorded", config.teleportToNodes ? "nodes" : "links");
+  m_report.method = "directed links";
+  m_report.teleportation = fmt::format(FMT_STRING("{}, to {}"), config.recordedTeleportation ? "recorded" : "unrecorded", config.teleportToNodes ? "nodes" : "links");
 
   // Calculate the teleport rate distribution
   if (config.teleportToNodes) {
     double sumNodeWeights = 0.0;
 
+    // The nodes are in CSR order.
+    unsigned int csrIndex = 0;
     for (const auto& nodeIt : network.nodes()) {
       auto& node = nodeIt.second;
-      nodeTeleportWeights[nodeIndexMap[node.id]] = node.weight;
+      nodeTeleportWeights[csrNodeIndex[csrIndex++]] = node.weight;
       sumNodeWeights += node.weight;
     }
 
@@ -449,19 +748,20 @@ void FlowCalculator::calcDirectedFlow(const StateNetwork& network, const Config&
     // Teleport to links
 
     // Teleport proportionally to out-degree, or in-degree if recorded teleportation.
-    for (const auto& link : flowLinks) {
-      auto toNode = config.recordedTeleportation ? link.target : link.source;
-      nodeTeleportWeights[toNode] += link.flow / sumLinkWeight;
-    }
+    flowLinks.forEach([&](unsigned int source, unsigned int target, double flow) {
+      auto toNode = config.recordedTeleportation ? target : source;
+      nodeTeleportWeights[toNode] += flow / sumLinkWeight;
+    });
   }
 
   // Normalize link weights with respect to its source nodes total out-link weight;
-  for (auto& link : flowLinks) {
-    if (sumLinkOutWeight[link.source] > 0) {
-      link.flow /= sumLinkOutWeight[link.source];
+  flowLinks.forEach([&](unsigned int source, unsigned int, double& flow) {
+    if (sumLinkOutWeight[source] > 0) {
+      flow /= sumLinkOutWeight[source];
     }
-  }
+  });
 
+  const auto inLinks = groupByTarget(flowLinks, numNodes, 0, flowLinks.size());
   std::vector<double> nodeFlowTmp(numNodes, 0.0);
   double danglingRank;
 
@@ -469,24 +769,17 @@ void FlowCalculator::calcDirectedFlow(const StateNetwork& network, const Config&
   const auto iteration = [&](const auto iter, const double alpha, const double beta) {
     danglingRank = accumulateDanglingRank();
 
-    // Flow from teleportation
+    // Flow from teleportation and links, and the change from the last iteration.
+    // Start the sum with -1.0 so we don't have to subtract it later.
     const auto teleportationFlow = alpha + beta * danglingRank;
-    for (unsigned int i = 0; i < numNodes; ++i) {
-      nodeFlowTmp[i] = teleportationFlow * nodeTeleportWeights[i];
-    }
-
-    // Flow from links
-    for (const auto& link : flowLinks) {
-      nodeFlowTmp[link.target] += beta * link.flow * nodeFlow[link.source];
-    }
-
-    // Update node flow from the power iteration above and check if converged
-    double nodeFlowDiff = -1.0; // Start with -1.0 so we don't have to subtract it later
-    double error = 0.0;
-    for (unsigned int i = 0; i < numNodes; ++i) {
-      nodeFlowDiff += nodeFlowTmp[i];
-      error += std::abs(nodeFlowTmp[i] - nodeFlow[i]);
-    }
+    const auto sums = sumOverNodes(0, numNodes, { -1.0, 0.0 }, [&](unsigned int i, FlowSums& sum) {
+      const auto flow = pullFlow(inLinks, i, beta, nodeFlow, teleportationFlow * nodeTeleportWeights[i]);
+      nodeFlowTmp[i] = flow;
+      sum.first += flow;
+      sum.second += std::abs(flow - nodeFlow[i]);
+    });
+    const double nodeFlowDiff = sums.first;
+    const double error = sums.second;
 
     nodeFlow = nodeFlowTmp;
 
@@ -499,8 +792,14 @@ void FlowCalculator::calcDirectedFlow(const StateNetwork& network, const Config&
     return error;
   };
 
-  const auto result = powerIterate(config, config.teleportationProbability, iteration);
+  const auto alpha = config.teleportationProbability;
+  const auto coldError = warmStart(network, [&]() { return iteration(0u, alpha, 1.0 - alpha); });
+  if (m_warmStartNodes > 0 && !config.recordedTeleportation)
+    addUnrecordedTeleportation(alpha);
+  const auto result = powerIterate(config, alpha, nodeFlow, iteration);
   recordPageRank(result.iterations, result.error, result.converged);
+  recordExtrapolations(config, result.extrapolations);
+  recordWarmStart(config, coldError, result.errors);
 
   double sumNodeRank = 1.0;
   double beta = result.beta;
@@ -509,20 +808,19 @@ void FlowCalculator::calcDirectedFlow(const StateNetwork& network, const Config&
     // Take one last power iteration excluding the teleportation
     // and normalize node flow
     sumNodeRank = 1.0 - danglingRank;
-    nodeFlow.assign(numNodes, 0.0);
-
-    for (const auto& link : flowLinks) {
-      nodeFlow[link.target] += link.flow * nodeFlowTmp[link.source] / sumNodeRank;
-    }
+    forEachNode(0, numNodes, [&](unsigned int i) {
+      double flow = 0.0;
+      for (auto k = inLinks.offsets[i]; k < inLinks.offsets[i + 1]; ++k)
+        flow += inLinks.flows[k] * nodeFlowTmp[inLinks.sources[k]] / sumNodeRank;
+      nodeFlow[i] = flow;
+    });
 
     beta = 1.0;
   }
 
   // Update the links with their global flow from the PageRank values.
   // Note: beta is set to 1 if unrecorded teleportation
-  for (auto& link : flowLinks) {
-    link.flow *= beta * nodeFlowTmp[link.source] / sumNodeRank;
-  }
+  scaleLinkFlows(flowLinks, [&](unsigned int source) { return beta * nodeFlowTmp[source] / sumNodeRank; });
 }
 
 void FlowCalculator::calcDirectedRelaxToSelfFlow(const StateNetwork& network, const Config& config) noexcept
@@ -536,16 +834,18 @@ void FlowCalculator::calcDirectedRelaxToSelfFlow(const StateNetwork& network, co
   // transition, so the stationary node flow is exactly spread's on the compact
   // O(L*k) network -- the same two-step trick as calcDirectedBipartiteFlow. The
   // matching link flow is produced in finalize().
-  m_flowMethod = "directed multilayer relax-to-self (two-step)";
-  m_teleportation = fmt::format(FMT_STRING("{}, to {}"), config.recordedTeleportation ? "recorded" : "unrecorded", config.teleportToNodes ? "nodes" : "links");
+  m_report.method = "directed multilayer relax-to-self (two-step)";
+  m_report.teleportation = fmt::format(FMT_STRING("{}, to {}"), config.recordedTeleportation ? "recorded" : "unrecorded", config.teleportToNodes ? "nodes" : "links");
 
   // Calculate the teleport rate distribution
   if (config.teleportToNodes) {
     double sumNodeWeights = 0.0;
 
+    // The nodes are in CSR order.
+    unsigned int csrIndex = 0;
     for (const auto& nodeIt : network.nodes()) {
       auto& node = nodeIt.second;
-      nodeTeleportWeights[nodeIndexMap[node.id]] = node.weight;
+      nodeTeleportWeights[csrNodeIndex[csrIndex++]] = node.weight;
       sumNodeWeights += node.weight;
     }
 
@@ -554,76 +854,80 @@ void FlowCalculator::calcDirectedRelaxToSelfFlow(const StateNetwork& network, co
     // Teleport to links
 
     // Teleport proportionally to out-degree, or in-degree if recorded teleportation.
-    for (const auto& link : flowLinks) {
-      auto toNode = config.recordedTeleportation ? link.target : link.source;
-      nodeTeleportWeights[toNode] += link.flow / sumLinkWeight;
-    }
+    flowLinks.forEach([&](unsigned int source, unsigned int target, double flow) {
+      auto toNode = config.recordedTeleportation ? target : source;
+      nodeTeleportWeights[toNode] += flow / sumLinkWeight;
+    });
   }
 
   // Normalize link weights with respect to its source nodes total out-link weight;
-  for (auto& link : flowLinks) {
-    if (sumLinkOutWeight[link.source] > 0) {
-      link.flow /= sumLinkOutWeight[link.source];
+  flowLinks.forEach([&](unsigned int source, unsigned int, double& flow) {
+    if (sumLinkOutWeight[source] > 0) {
+      flow /= sumLinkOutWeight[source];
     }
-  }
+  });
 
   // Classify links (inter-layer vs intra-layer) and accumulate per-node intra-layer out-mass.
   std::vector<unsigned int> physId(numNodes, 0);
+  unsigned int csrIndex = 0;
   for (const auto& nodeIt : network.nodes()) {
-    physId[nodeIndexMap[nodeIt.second.id]] = nodeIt.second.physicalId;
+    physId[csrNodeIndex[csrIndex++]] = nodeIt.second.physicalId;
   }
   std::vector<char> isInterLayer(flowLinks.size(), 0);
   std::vector<double> intraOutSum(numNodes, 0.0);
   for (unsigned int k = 0; k < flowLinks.size(); ++k) {
-    const auto& link = flowLinks[k];
-    if (physId[link.source] == physId[link.target] && link.source != link.target) {
+    const auto source = flowLinks.source[k];
+    const auto target = flowLinks.target[k];
+    if (physId[source] == physId[target] && source != target) {
       isInterLayer[k] = 1;
     } else {
-      intraOutSum[link.source] += link.flow;
+      intraOutSum[source] += flowLinks.flow[k];
     }
   }
 
+  const auto interInLinks = groupByTarget(flowLinks, numNodes, 0, flowLinks.size(), [&](std::size_t k) { return isInterLayer[k] != 0; });
+  const auto intraInLinks = groupByTarget(flowLinks, numNodes, 0, flowLinks.size(), [&](std::size_t k) { return isInterLayer[k] == 0; });
   std::vector<double> nodeFlowTmp(numNodes, 0.0);
   std::vector<double> interArrived(numNodes, 0.0);
   double danglingRank;
 
   // One fused transition step. First pass: every intra-layer link makes the ordinary
   // one-hop dst += beta * P(src->dst) * src[src], while flow arriving on an inter-layer
-  // link is held back in interArrived (its target is not visited). Second pass: push
-  // that held-back flow on through the target's intra-layer out-links, split by their
-  // transition probability -- the deferred relax intra-step.
+  // link is held back in interArrived (its target is not visited). Second pass, once
+  // all of it has arrived: push that held-back flow on through the target's
+  // intra-layer out-links, split by their transition probability -- the deferred
+  // relax intra-step.
   const auto twoStep = [&](const double beta, const std::vector<double>& src, std::vector<double>& dst) {
-    std::fill(interArrived.begin(), interArrived.end(), 0.0);
-    for (unsigned int k = 0; k < flowLinks.size(); ++k) {
-      const auto& link = flowLinks[k];
-      if (isInterLayer[k]) {
-        interArrived[link.target] += beta * link.flow * src[link.source];
-      } else {
-        dst[link.target] += beta * link.flow * src[link.source];
-      }
-    }
-    for (unsigned int k = 0; k < flowLinks.size(); ++k) {
-      const auto& link = flowLinks[k];
-      if (!isInterLayer[k] && intraOutSum[link.source] > 0.0) {
-        dst[link.target] += interArrived[link.source] * link.flow / intraOutSum[link.source];
+    forEachNode(0, numNodes, [&](unsigned int i) {
+      interArrived[i] = pullFlow(interInLinks, i, beta, src, 0.0);
+      dst[i] = pullFlow(intraInLinks, i, beta, src, dst[i]);
+    });
+    forEachNode(0, numNodes, [&](unsigned int i) {
+      double flow = dst[i];
+      for (auto k = intraInLinks.offsets[i]; k < intraInLinks.offsets[i + 1]; ++k) {
+        const auto source = intraInLinks.sources[k];
+        if (intraOutSum[source] > 0.0) {
+          flow += interArrived[source] * intraInLinks.flows[k] / intraOutSum[source];
+        }
       }
-    }
+      dst[i] = flow;
+    });
   };
 
   const auto iteration = [&](const auto iter, const double alpha, const double beta) {
     danglingRank = accumulateDanglingRank();
     const auto teleportationFlow = alpha + beta * danglingRank;
-    for (unsigned int i = 0; i < numNodes; ++i) {
+    forEachNode(0, numNodes, [&](unsigned int i) {
       nodeFlowTmp[i] = teleportationFlow * nodeTeleportWeights[i];
-    }
+    });
     twoStep(beta, nodeFlow, nodeFlowTmp);
 
-    double nodeFlowDiff = -1.0;
-    double error = 0.0;
-    for (unsigned int i = 0; i < numNodes; ++i) {
-      nodeFlowDiff += nodeFlowTmp[i];
-      error += std::abs(nodeFlowTmp[i] - nodeFlow[i]);
-    }
+    const auto sums = sumOverNodes(0, numNodes, { -1.0, 0.0 }, [&](unsigned int i, FlowSums& sum) {
+      sum.first += nodeFlowTmp[i];
+      sum.second += std::abs(nodeFlowTmp[i] - nodeFlow[i]);
+    });
+    const double nodeFlowDiff = sums.first;
+    const double error = sums.second;
     nodeFlow = nodeFlowTmp;
     if (std::abs(nodeFlowDiff) > 1.0e-10) {
       Console::detail(1, "normalizing flow after {} power iterations with error {:g}", iter, nodeFlowDiff);
@@ -632,8 +936,14 @@ void FlowCalculator::calcDirectedRelaxToSelfFlow(const StateNetwork& network, co
     return error;
   };
 
-  const auto result = powerIterate(config, config.teleportationProbability, iteration);
+  const auto alpha = config.teleportationProbability;
+  const auto coldError = warmStart(network, [&]() { return iteration(0u, alpha, 1.0 - alpha); });
+  if (m_warmStartNodes > 0 && !config.recordedTeleportation)
+    addUnrecordedTeleportation(alpha);
+  const auto result = powerIterate(config, alpha, nodeFlow, iteration);
   recordPageRank(result.iterations, result.error, result.converged);
+  recordExtrapolations(config, result.extrapolations);
+  recordWarmStart(config, coldError, result.errors);
 
   double sumNodeRank = 1.0;
   double beta = result.beta;
@@ -652,15 +962,13 @@ void FlowCalculator::calcDirectedRelaxToSelfFlow(const StateNetwork& network, co
   // Update the links with their global flow from the PageRank values.
   // (Inter-layer links get their transit flow here; finalize() also relays it onto
   // the target's intra-layer links for the matching two-step link flow.)
-  for (auto& link : flowLinks) {
-    link.flow *= beta * nodeFlowTmp[link.source] / sumNodeRank;
-  }
+  scaleLinkFlows(flowLinks, [&](unsigned int source) { return beta * nodeFlowTmp[source] / sumNodeRank; });
 }
 
 void FlowCalculator::calcDirectedRegularizedFlow(const StateNetwork& network, const Config& config) noexcept
 {
-  m_flowMethod = "directed regularized flow";
-  m_teleportation = "recorded, Bayesian prior to nodes";
+  m_report.method = "directed regularized flow";
+  m_report.teleportation = "recorded, Bayesian prior to nodes";
 
   // Calculate node weights w_i = s_i/k_i, where s_i is the node strength (weighted degree) and k_i the (unweighted) degree
   unsigned int N = network.numNodes();
@@ -680,12 +988,12 @@ void FlowCalculator::calcDirectedRegularizedFlow(const StateNetwork& network, co
   }
   double average_weight = sum_s / sum_k;
 
-  for (auto& link : flowLinks) {
-    k_out[link.source] += 1;
-    s_out[link.source] += link.flow;
-    k_in[link.target] += 1;
-    s_in[link.target] += link.flow;
-  }
+  flowLinks.forEach([&](unsigned int source, unsigned int target, double flow) {
+    k_out[source] += 1;
+    s_out[source] += flow;
+    k_in[target] += 1;
+    s_in[target] += flow;
+  });
 
   double min_u_out = std::numeric_limits<double>::max();
   double min_u_in = std::numeric_limits<double>::max();
@@ -735,11 +1043,11 @@ void FlowCalculator::calcDirectedRegularizedFlow(const StateNetwork& network, co
   }
 
   // Normalize link weights with respect to its source nodes total out-link weight;
-  for (auto& link : flowLinks) {
-    if (sumLinkOutWeight[link.source] > 0) {
-      link.flow /= sumLinkOutWeight[link.source];
+  flowLinks.forEach([&](unsigned int source, unsigned int, double& flow) {
+    if (sumLinkOutWeight[source] > 0) {
+      flow /= sumLinkOutWeight[source];
     }
-  }
+  });
 
   std::vector<double> nodeFlowTmp(numNodes, 0.0);
 
@@ -755,10 +1063,10 @@ void FlowCalculator::calcDirectedRegularizedFlow(const StateNetwork& network, co
     }
 
     // Flow from links
-    for (const auto& link : flowLinks) {
-      double beta = 1 - alpha[link.source] * (config.noSelfLinks ? 1 - nodeTeleportWeights[link.source] : 1);
-      nodeFlowTmp[link.target] += beta * link.flow * nodeFlow[link.source];
-    }
+    flowLinks.forEach([&](unsigned int source, unsigned int target, double flow) {
+      double beta = 1 - alpha[source] * (config.noSelfLinks ? 1 - nodeTeleportWeights[source] : 1);
+      nodeFlowTmp[target] += beta * flow * nodeFlow[source];
+    });
 
     // Update node flow from the power iteration above and check if converged
     double nodeFlowDiff = -1.0; // Start with -1.0 so we don't have to subtract it later
@@ -779,27 +1087,35 @@ void FlowCalculator::calcDirectedRegularizedFlow(const StateNetwork& network, co
     return error;
   };
 
+  const auto coldError = warmStart(network, [&]() { return iteration(0u); });
   unsigned int iterations = 0;
   double err = 0.0;
+  FlowExtrapolation extrapolation(config.flowAcceleration, numNodes);
+  std::vector<double> errors;
 
   do {
+    extrapolation.extrapolateIfDue(nodeFlow);
     err = iteration(iterations);
+    extrapolation.record(nodeFlow, err);
+    errors.push_back(err);
 
     ++iterations;
   } while (iterations < config.maxFlowIterations && (err > config.flowTolerance || iterations < config.minFlowIterations));
 
   const bool converged = errorWithinFlowTolerance(config, err);
   recordPageRank(iterations, err, converged);
+  recordExtrapolations(config, extrapolation.numExtrapolations());
+  recordWarmStart(config, coldError, errors);
   if (!converged) {
     Log() << "\n";
     Console::warn(0, "PageRank calculation did not converge after {} iterations with error {:g}.", iterations, err);
   }
 
   double sumNodeRank = 1.0;
-  for (auto& link : flowLinks) {
-    double beta = 1 - alpha[link.source] * (config.noSelfLinks ? 1 - nodeTeleportWeights[link.source] : 1);
-    link.flow *= beta * nodeFlow[link.source] / sumNodeRank;
-  }
+  flowLinks.forEach([&](unsigned int source, unsigned int, double& flow) {
+    double beta = 1 - alpha[source] * (config.noSelfLinks ? 1 - nodeTeleportWeights[source] : 1);
+    flow *= beta * nodeFlow[source] / sumNodeRank;
+  });
 
   nodeTeleportFlow.assign(numNodes, 0.0);
   for (unsigned int i = 0; i < N; ++i) {
@@ -837,27 +1153,28 @@ void FlowCalculator::calcDirectedRegularizedMultilayerFlow(const StateNetwork& n
   std::vector<bool> isInterLink(flowLinks.size(), false);
   std::vector<unsigned int> layerIndices(N);
 
+  unsigned int csrIndex = 0;
   for (const auto& node : network.nodes()) {
-    const auto nodeIndex = nodeIndexMap[node.second.id];
+    const auto nodeIndex = csrNodeIndex[csrIndex++];
     layerIds[nodeIndex] = node.second.layerId;
     physicalIds[nodeIndex] = node.second.physicalId;
     layerIndices[nodeIndex] = layerIdToIndex[node.second.layerId];
-    // nodeTeleportWeights[nodeIndexMap[nodeId]] = node.weight;
+    // nodeTeleportWeights[nodeIndex] = node.weight;
     // if (layerIdToIndex.count(node.second.layerId) == 0) {
     //   layerIdToIndex[node.second.layerId] = layerIndex++;
     // }
-    // Log(1) << "Node (physId: " << node.second.physicalId << ", layerId: " << node.second.layerId << ") -> index: " << nodeIndexMap[node.second.id] << "\n";
+    // Log(1) << "Node (physId: " << node.second.physicalId << ", layerId: " << node.second.layerId << ") -> index: " << nodeIndex << "\n";
   }
 
   unsigned int linkIndex = 0;
 
   // Log(1) << "\nLinks:\n";
 
-  for (const auto& link : flowLinks) {
-    isInterLink[linkIndex] = physicalIds[link.source] == physicalIds[link.target];
-    // Log(1) << linkIndex << ": (" << layerIds[link.source] << "," << physicalIds[link.source] << ") -> (" << layerIds[link.target] << "," << physicalIds[link.target] << ") is inter: " << isInterLink[linkIndex] << "\n";
+  flowLinks.forEach([&](unsigned int source, unsigned int target, double) {
+    isInterLink[linkIndex] = physicalIds[source] == physicalIds[target];
+    // Log(1) << linkIndex << ": (" << layerIds[source] << "," << physicalIds[source] << ") -> (" << layerIds[target] << "," << physicalIds[target] << ") is inter: " << isInterLink[linkIndex] << "\n";
     ++linkIndex;
-  }
+  });
 
   std::vector<unsigned int> k_out(N, 0);
   std::vector<unsigned int> k_in(N, 0);
@@ -869,19 +1186,19 @@ void FlowCalculator::calcDirectedRegularizedMultilayerFlow(const StateNetwork& n
   // double average_weight = sum_s / sum_k;
 
   linkIndex = 0;
-  for (auto& link : flowLinks) {
+  flowLinks.forEach([&](unsigned int source, unsigned int target, double flow) {
     if (isInterLink[linkIndex++]) {
-      inter_out[link.source] += link.flow;
+      inter_out[source] += flow;
     } else {
-      k_out[link.source] += 1;
-      s_out[link.source] += link.flow;
-      k_in[link.target] += 1;
-      s_in[link.target] += link.flow;
-      // if (link.source == 0) {
-      //   Log(1) << link.source << " -> " << link.target << " => k_out[0] -> " << k_out[link.source] << "\n";
+      k_out[source] += 1;
+      s_out[source] += flow;
+      k_in[target] += 1;
+      s_in[target] += flow;
+      // if (source == 0) {
+      //   Log(1) << source << " -> " << target << " => k_out[0] -> " << k_out[source] << "\n";
       // }
     }
-  }
+  });
 
   // auto gamma = [s_out, intraOutWeight, interOutWeight](auto i) { return 1 + interOutWeight / (s_out[i] + intraOutWeight); };
 
@@ -943,19 +1260,19 @@ void FlowCalculator::calcDirectedRegularizedMultilayerFlow(const StateNetwork& n
   // Log(1) << "\nLink probabilities:\n";
   // Normalize link weights to probabilities, separate for intra and inter links
   linkIndex = 0;
-  for (auto& link : flowLinks) {
-    // if (sumLinkOutWeight[link.source] > 0) {
-    //   link.flow /= sumLinkOutWeight[link.source];
+  flowLinks.forEach([&](unsigned int source, unsigned int, double& flow) {
+    // if (sumLinkOutWeight[source] > 0) {
+    //   flow /= sumLinkOutWeight[source];
     // }
     if (isInterLink[linkIndex++]) {
-      link.flow /= inter_out[link.source];
+      flow /= inter_out[source];
     } else {
-      if (k_out[link.source] > 0) {
-        link.flow /= s_out[link.source];
+      if (k_out[source] > 0) {
+        flow /= s_out[source];
       }
     }
-    // Log(1) << link.source << " -> " << link.target << ": " << link.flow << "\n";
-  }
+    // Log(1) << source << " -> " << target << ": " << flow << "\n";
+  });
 
   std::vector<double> unrecordedInterFlow(N, 0);
   std::vector<double> nodeFlowTmp(numNodes, 0.0);
@@ -972,14 +1289,14 @@ void FlowCalculator::calcDirectedRegularizedMultilayerFlow(const StateNetwork& n
     // 1. Unrecorded inter-layer step: push fraction of flow on inter-layer links to temporary location
     linkIndex = 0;
     unrecordedInterFlow.assign(N, 0.0);
-    for (auto& link : flowLinks) {
+    flowLinks.forEach([&](unsigned int source, unsigned int target, double flow) {
       if (!isInterLink[linkIndex++]) {
-        continue;
+        return;
       }
-      unrecordedInterFlow[link.target] += alphaInter[link.source] * nodeFlow[link.source] * link.flow;
-      // unrecordedInterFlow[link.target] += alphaInter[link.source] * nodeFlow[link.source] * link.flow * (config.noSelfLinks ? 1 - nodeTeleportWeights[link.source] : 1);
-      // Log(1) << "  " << link.source << " -> " << link.target << ": unrecorded[" << link.target << "] += " << nodeFlow[link.source] << " * " << alphaInter[link.source] << " * " << link.flow << "\n";
-    }
+      unrecordedInterFlow[target] += alphaInter[source] * nodeFlow[source] * flow;
+      // unrecordedInterFlow[target] += alphaInter[source] * nodeFlow[source] * flow * (config.noSelfLinks ? 1 - nodeTeleportWeights[source] : 1);
+      // Log(1) << "  " << source << " -> " << target << ": unrecorded[" << target << "] += " << nodeFlow[source] << " * " << alphaInter[source] << " * " << flow << "\n";
+    });
 
     // double sumFlow = 0.0;
     // double sumUnrecordedFlow = 0.0;
@@ -1009,14 +1326,14 @@ void FlowCalculator::calcDirectedRegularizedMultilayerFlow(const StateNetwork& n
 
     // Flow from links
     linkIndex = 0;
-    for (const auto& link : flowLinks) {
+    flowLinks.forEach([&](unsigned int source, unsigned int target, double flow) {
       if (isInterLink[linkIndex++]) {
-        continue;
+        return;
       }
-      double beta = 1 - alpha[link.source] * (config.noSelfLinks ? 1 - nodeTeleportWeights[link.source] : 1);
-      // double beta = 1 - alpha[link.source];
-      nodeFlowTmp[link.target] += beta * link.flow * ((1 - alphaInter[link.source]) * nodeFlow[link.source] + unrecordedInterFlow[link.source]);
-    }
+      double beta = 1 - alpha[source] * (config.noSelfLinks ? 1 - nodeTeleportWeights[source] : 1);
+      // double beta = 1 - alpha[source];
+      nodeFlowTmp[target] += beta * flow * ((1 - alphaInter[source]) * nodeFlow[source] + unrecordedInterFlow[source]);
+    });
 
     // Update node flow from the power iteration above and check if converged
     double nodeFlowDiff = -1.0; // Start with -1.0 so we don't have to subtract it later
@@ -1040,11 +1357,17 @@ void FlowCalculator::calcDirectedRegularizedMultilayerFlow(const StateNetwork& n
     return error;
   };
 
+  const auto coldError = warmStart(network, [&]() { return iteration(0u); });
   unsigned int iterations = 0;
   double err = 0.0;
+  FlowExtrapolation extrapolation(config.flowAcceleration, numNodes);
+  std::vector<double> errors;
 
   do {
+    extrapolation.extrapolateIfDue(nodeFlow);
     err = iteration(iterations);
+    extrapolation.record(nodeFlow, err);
+    errors.push_back(err);
 
     ++iterations;
   } while (iterations < config.maxFlowIterations && (err > config.flowTolerance || iterations < config.minFlowIterations));
@@ -1053,6 +1376,8 @@ void FlowCalculator::calcDirectedRegularizedMultilayerFlow(const StateNetwork& n
   // model: this loop warned but reported nothing, leaving the run report without a flow
   // object at all for regularized multilayer input.
   recordPageRank(iterations, err, errorWithinFlowTolerance(config, err));
+  recordExtrapolations(config, extrapolation.numExtrapolations());
+  recordWarmStart(config, coldError, errors);
   if (!errorWithinFlowTolerance(config, err)) {
     Console::warn(0, "PageRank calculation stopped after the maximum of {} iterations with diff {:g}.", iterations, err);
   }
@@ -1064,19 +1389,19 @@ void FlowCalculator::calcDirectedRegularizedMultilayerFlow(const StateNetwork& n
   linkIndex = 0;
   enterFlow.assign(numNodes, 0.0);
   exitFlow.assign(numNodes, 0.0);
-  for (auto& link : flowLinks) {
+  flowLinks.forEach([&](unsigned int source, unsigned int target, double& flow) {
     if (isInterLink[linkIndex++]) {
-      link.flow = alphaInter[link.source] * nodeFlow[link.source] * link.flow;
+      flow = alphaInter[source] * nodeFlow[source] * flow;
       // Need to add enter/exit flow to eventually collapse
-      exitFlow[link.source] += link.flow;
-      enterFlow[link.target] += link.flow;
+      exitFlow[source] += flow;
+      enterFlow[target] += flow;
     } else {
-      double beta = 1 - alpha[link.source];
-      link.flow = beta * link.flow * ((1 - alphaInter[link.source]) * nodeFlow[link.source] + unrecordedInterFlow[link.source]);
-      exitFlow[link.source] += link.flow;
-      enterFlow[link.target] += link.flow;
+      double beta = 1 - alpha[source];
+      flow = beta * flow * ((1 - alphaInter[source]) * nodeFlow[source] + unrecordedInterFlow[source]);
+      exitFlow[source] += flow;
+      enterFlow[target] += flow;
     }
-  }
+  });
 
   nodeTeleportFlow.assign(numNodes, 0.0);
   for (unsigned int i = 0; i < N; ++i) {
@@ -1090,8 +1415,8 @@ void FlowCalculator::calcDirectedRegularizedMultilayerFlow(const StateNetwork& n
 
 void FlowCalculator::calcUndirectedRegularizedFlow(const StateNetwork& network, const Config& config) noexcept
 {
-  m_flowMethod = "undirected regularized flow";
-  m_teleportation = "recorded, Bayesian prior to nodes";
+  m_report.method = "undirected regularized flow";
+  m_report.teleportation = "recorded, Bayesian prior to nodes";
 
   // Calculate node weights w_i = s_i/k_i, where s_i is the node strength (weighted degree) and k_i the (unweighted) degree
   unsigned int N = network.numNodes();
@@ -1108,14 +1433,14 @@ void FlowCalculator::calcUndirectedRegularizedFlow(const StateNetwork& network,
   }
   double average_weight = sum_s / sum_k;
 
-  for (auto& link : flowLinks) {
-    k[link.source] += 1;
-    s[link.source] += link.flow;
-    if (link.source != link.target) {
-      k[link.target] += 1;
-      s[link.target] += link.flow;
+  flowLinks.forEach([&](unsigned int source, unsigned int target, double flow) {
+    k[source] += 1;
+    s[source] += flow;
+    if (source != target) {
+      k[target] += 1;
+      s[target] += flow;
     }
-  }
+  });
 
   double min_u = std::numeric_limits<double>::max();
   for (unsigned int i = 0; i < N; ++i) {
@@ -1162,11 +1487,11 @@ void FlowCalculator::calcUndirectedRegularizedFlow(const StateNetwork& network,
     sum_t += t_i;
   }
 
-  for (auto& link : flowLinks) {
-    if (sumLinkOutWeight[link.source] > 0) {
-      link.flow /= sumLinkOutWeight[link.source];
+  flowLinks.forEach([&](unsigned int source, unsigned int, double& flow) {
+    if (sumLinkOutWeight[source] > 0) {
+      flow /= sumLinkOutWeight[source];
     }
-  }
+  });
 
   for (unsigned int i = 0; i < N; ++i) {
     nodeFlow[i] = (s[i] + t(i)) / (sum_s + sum_t);
@@ -1177,11 +1502,11 @@ void FlowCalculator::calcUndirectedRegularizedFlow(const StateNetwork& network,
     nodeTeleportFlow[i] = nodeFlow[i] * alpha[i];
   }
 
-  for (auto& link : flowLinks) {
+  flowLinks.forEach([&](unsigned int source, unsigned int, double& flow) {
     // TODO: Side effect from inflating alpha, need real alpha here.
-    double beta = 1 - alpha[link.source] * (config.noSelfLinks ? 1 - nodeTeleportWeights[link.source] : 1);
-    link.flow *= beta * nodeFlow[link.source] * 2;
-  }
+    double beta = 1 - alpha[source] * (config.noSelfLinks ? 1 - nodeTeleportWeights[source] : 1);
+    flow *= beta * nodeFlow[source] * 2;
+  });
 }
 
 #if INFOMAP_FEATURE_REGULARIZED_MULTILAYER
@@ -1195,16 +1520,16 @@ void FlowCalculator::calcUndirectedRegularizedMultilayerFlow(const StateNetwork&
 
 void FlowCalculator::calcDirectedBipartiteFlow(const StateNetwork& network, const Config& config) noexcept
 {
-  m_flowMethod = "directed bipartite links";
-  m_teleportation = fmt::format(FMT_STRING("{}, to {}"), config.recordedTeleportation ? "recorded" : "unrecorded", config.teleportToNodes ? "nodes" : "links");
-
-  const auto bipartiteStartId = network.bipartiteStartId();
+  m_report.method = "directed bipartite links";
+  m_report.teleportation = fmt::format(FMT_STRING("{}, to {}"), config.recordedTeleportation ? "recorded" : "unrecorded", config.teleportToNodes ? "nodes" : "links");
 
   if (config.teleportToNodes) {
+    // The nodes are in CSR order, with the primary nodes first.
+    unsigned int csrIndex = 0;
     for (const auto& nodeIt : network.nodes()) {
-      auto& node = nodeIt.second;
-      if (node.id < bipartiteStartId) {
-        nodeTeleportWeights[nodeIndexMap[node.id]] = node.weight;
+      const auto nodeIndex = csrNodeIndex[csrIndex++];
+      if (nodeIndex < bipartiteStartIndex) {
+        nodeTeleportWeights[nodeIndex] = nodeIt.second.weight;
       }
     }
   } else {
@@ -1212,16 +1537,16 @@ void FlowCalculator::calcDirectedBipartiteFlow(const StateNetwork& network, cons
     // Two-step degree: sum of products between incoming and outgoing links from bipartite nodes
 
     if (config.recordedTeleportation) {
-      for (auto link = begin(flowLinks) + bipartiteLinkStartIndex; link != end(flowLinks); ++link) {
+      for (std::size_t k = bipartiteLinkStartIndex; k < flowLinks.size(); ++k) {
         // target is an ordinary node
-        nodeTeleportWeights[link->target] += link->flow;
+        nodeTeleportWeights[flowLinks.target[k]] += flowLinks.flow[k];
       }
     } else {
       // Unrecorded teleportation
 
-      for (auto link = begin(flowLinks); link != begin(flowLinks) + bipartiteLinkStartIndex; ++link) {
+      for (std::size_t k = 0; k < bipartiteLinkStartIndex; ++k) {
         // source is an ordinary node
-        nodeTeleportWeights[link->source] += link->flow;
+        nodeTeleportWeights[flowLinks.source[k]] += flowLinks.flow[k];
       }
     }
   }
@@ -1231,12 +1556,16 @@ void FlowCalculator::calcDirectedBipartiteFlow(const StateNetwork& network, cons
   nodeFlow = nodeTeleportWeights;
 
   // Normalize link weights with respect to its source nodes total out-link weight;
-  for (auto& link : flowLinks) {
-    if (sumLinkOutWeight[link.source] > 0) {
-      link.flow /= sumLinkOutWeight[link.source];
+  flowLinks.forEach([&](unsigned int source, unsigned int, double& flow) {
+    if (sumLinkOutWeight[source] > 0) {
+      flow /= sumLinkOutWeight[source];
     }
-  }
+  });
 
+  // Bipartite links cross sides: the first step runs from primary to feature
+  // nodes and the second back, so each step reads one side and writes the other.
+  const auto featureInLinks = groupByTarget(flowLinks, numNodes, 0, bipartiteLinkStartIndex);
+  const auto primaryInLinks = groupByTarget(flowLinks, numNodes, bipartiteLinkStartIndex, flowLinks.size());
   std::vector<double> nodeFlowTmp(numNodes, 0.0);
   double danglingRank;
 
@@ -1244,34 +1573,24 @@ void FlowCalculator::calcDirectedBipartiteFlow(const StateNetwork& network, cons
   const auto iteration = [&](const auto iter, const double alpha, const double beta) {
     danglingRank = accumulateDanglingRank();
 
-    // Flow from teleportation
-    const auto teleportationFlow = alpha + beta * danglingRank;
-    for (unsigned int i = 0; i < bipartiteStartIndex; ++i) {
-      nodeFlowTmp[i] = teleportationFlow * nodeTeleportWeights[i];
-    }
-
-    for (unsigned int i = bipartiteStartIndex; i < numNodes; ++i) {
-      nodeFlowTmp[i] = 0.0;
-    }
-
     // Flow from links
     // First step
-    for (auto link = begin(flowLinks); link != begin(flowLinks) + bipartiteLinkStartIndex; ++link) {
-      nodeFlow[link->target] += beta * link->flow * nodeFlow[link->source];
-    }
-
-    // Second step back to primary nodes
-    for (auto link = begin(flowLinks) + bipartiteLinkStartIndex; link != end(flowLinks); ++link) {
-      nodeFlowTmp[link->target] += link->flow * nodeFlow[link->source];
-    }
+    forEachNode(bipartiteStartIndex, numNodes, [&](unsigned int i) {
+      nodeFlowTmp[i] = 0.0;
+      nodeFlow[i] = pullFlow(featureInLinks, i, beta, nodeFlow, nodeFlow[i]);
+    });
 
-    // Update node flow from the power iteration above and check if converged
-    double nodeFlowDiff = -1.0;
-    double error = 0.0;
-    for (unsigned int i = 0; i < bipartiteStartIndex; ++i) {
-      nodeFlowDiff += nodeFlowTmp[i];
-      error += std::abs(nodeFlowTmp[i] - nodeFlow[i]);
-    }
+    // Second step back to primary nodes, on top of the flow from teleportation,
+    // and the change from the last iteration
+    const auto teleportationFlow = alpha + beta * danglingRank;
+    const auto sums = sumOverNodes(0, bipartiteStartIndex, { -1.0, 0.0 }, [&](unsigned int i, FlowSums& sum) {
+      const auto flow = pullFlow(primaryInLinks, i, 1.0, nodeFlow, teleportationFlow * nodeTeleportWeights[i]);
+      nodeFlowTmp[i] = flow;
+      sum.first += flow;
+      sum.second += std::abs(flow - nodeFlow[i]);
+    });
+    const double nodeFlowDiff = sums.first;
+    const double error = sums.second;
 
     nodeFlow = nodeFlowTmp;
 
@@ -1284,8 +1603,9 @@ void FlowCalculator::calcDirectedBipartiteFlow(const StateNetwork& network, cons
     return error;
   };
 
-  const auto result = powerIterate(config, config.teleportationProbability, iteration);
+  const auto result = powerIterate(config, config.teleportationProbability, nodeFlow, iteration);
   recordPageRank(result.iterations, result.error, result.converged);
+  recordExtrapolations(config, result.extrapolations);
 
   double sumNodeRank = 1.0;
   double beta = result.beta;
@@ -1295,22 +1615,20 @@ void FlowCalculator::calcDirectedBipartiteFlow(const StateNetwork& network, cons
     sumNodeRank = 1.0 - danglingRank;
     nodeFlow.assign(numNodes, 0.0);
 
-    for (auto link = begin(flowLinks); link != begin(flowLinks) + bipartiteLinkStartIndex; ++link) {
-      nodeFlowTmp[link->target] += link->flow * nodeFlowTmp[link->source];
-    }
+    forEachNode(bipartiteStartIndex, numNodes, [&](unsigned int i) {
+      nodeFlowTmp[i] = pullFlow(featureInLinks, i, 1.0, nodeFlowTmp, nodeFlowTmp[i]);
+    });
     // Second step back to primary nodes
-    for (auto link = begin(flowLinks) + bipartiteLinkStartIndex; link != end(flowLinks); ++link) {
-      nodeFlow[link->target] += link->flow * nodeFlowTmp[link->source];
-    }
+    forEachNode(0, bipartiteStartIndex, [&](unsigned int i) {
+      nodeFlow[i] = pullFlow(primaryInLinks, i, 1.0, nodeFlowTmp, 0.0);
+    });
 
     beta = 1.0;
   }
 
   // Update the links with their global flow from the PageRank values.
   // Note: beta is set to 1 if unrecorded teleportation
-  for (auto& link : flowLinks) {
-    link.flow *= beta * nodeFlowTmp[link.source] / sumNodeRank;
-  }
+  scaleLinkFlows(flowLinks, [&](unsigned int source) { return beta * nodeFlowTmp[source] / sumNodeRank; });
 }
 
 void FlowCalculator::finalize(StateNetwork& network, const Config& config, bool normalizeNodeFlow) noexcept
@@ -1345,30 +1663,30 @@ void FlowCalculator::finalize(StateNetwork& network, const Config& config, bool
 
       // Only links between ordinary nodes and feature nodes in bipartite network
       // Don't code feature nodes -> distribute all flow from those to ordinary nodes
-      for (auto& link : flowLinks) {
-        auto sourceIsFeature = link.source >= bipartiteStartIndex;
+      flowLinks.forEach([&](unsigned int source, unsigned int target, double& flow) {
+        auto sourceIsFeature = source >= bipartiteStartIndex;
 
         if (sourceIsFeature) {
-          nodeFlow[link.target] += link.flow;
-          uncode(link.source); // Doesn't matter if done multiple times on each node.
+          nodeFlow[target] += flow;
+          uncode(source); // Doesn't matter if done multiple times on each node.
         } else {
-          nodeFlow[link.source] += link.flow;
-          uncode(link.target); // Doesn't matter if done multiple times on each node.
+          nodeFlow[source] += flow;
+          uncode(target); // Doesn't matter if done multiple times on each node.
         }
         // TODO: Should flow double before moving to nodes, does it cancel out in normalization?
 
         // Markov time 2 on the full network will correspond to markov time 1 between the real nodes.
-        link.flow *= 2;
-      }
+        flow *= 2;
+      });
       // TODO: Should flow double before moving to nodes, does it cancel out in normalization?
 
       normalizeNodeFlow = true;
 
     } else if (config.bipartiteTeleportation) {
-      for (auto& link : flowLinks) {
+      flowLinks.forEach([&](unsigned int, unsigned int, double& flow) {
         // Markov time 2 on the full network will correspond to markov time 1 between the real nodes.
-        link.flow *= 2;
-      }
+        flow *= 2;
+      });
     }
   }
 
@@ -1390,49 +1708,51 @@ void FlowCalculator::finalize(StateNetwork& network, const Config& config, bool
   // bipartite handling above.)
   if (config.multilayerRelaxToSelf && !network.isBipartite()) {
     std::vector<unsigned int> physId(numNodes, 0);
+    unsigned int csrIndex = 0;
     for (const auto& nodeIt : network.nodes()) {
-      physId[nodeIndexMap[nodeIt.second.id]] = nodeIt.second.physicalId;
+      physId[csrNodeIndex[csrIndex++]] = nodeIt.second.physicalId;
     }
     std::vector<std::vector<unsigned int>> outLinks(numNodes);
     for (unsigned int k = 0; k < flowLinks.size(); ++k) {
-      outLinks[flowLinks[k].source].push_back(k);
+      outLinks[flowLinks.source[k]].push_back(k);
     }
     std::vector<double> delta(flowLinks.size(), 0.0);
     for (unsigned int k = 0; k < flowLinks.size(); ++k) {
-      const auto& link = flowLinks[k];
-      const bool interLayer = physId[link.source] == physId[link.target] && link.source != link.target;
+      const auto source = flowLinks.source[k];
+      const unsigned int t = flowLinks.target[k];
+      const bool interLayer = physId[source] == physId[t] && source != t;
       if (!interLayer) {
         continue;
       }
-      const unsigned int t = link.target;
       double sumIntra = 0.0;
       for (const auto l : outLinks[t]) {
-        if (physId[flowLinks[l].target] != physId[t]) {
-          sumIntra += flowLinks[l].flow;
+        if (physId[flowLinks.target[l]] != physId[t]) {
+          sumIntra += flowLinks.flow[l];
         }
       }
       if (sumIntra <= 0.0) {
         continue; // dangling target: leave the inter-layer link as is
       }
-      const double f = link.flow;
+      const double f = flowLinks.flow[k];
       for (const auto l : outLinks[t]) {
-        if (physId[flowLinks[l].target] != physId[t]) {
-          delta[l] += f * flowLinks[l].flow / sumIntra;
+        if (physId[flowLinks.target[l]] != physId[t]) {
+          delta[l] += f * flowLinks.flow[l] / sumIntra;
         }
       }
       // The inter-layer link keeps its own flow (the layer switch); it is not dropped.
     }
     for (unsigned int k = 0; k < flowLinks.size(); ++k) {
-      flowLinks[k].flow += delta[k];
+      flowLinks.flow[k] += delta[k];
     }
   }
 
   if (config.useNodeWeightsAsFlow) {
     addFlowNote("Using node weights as flow");
 
+    unsigned int csrIndex = 0;
     for (auto& nodeIt : network.nodes()) {
       auto& node = nodeIt.second;
-      nodeFlow[nodeIndexMap[node.id]] = node.weight;
+      nodeFlow[csrNodeIndex[csrIndex++]] = node.weight;
     }
 
     normalizeNodeFlow = true;
@@ -1445,25 +1765,25 @@ void FlowCalculator::finalize(StateNetwork& network, const Config& config, bool
   // Write back flow to network
   double sumNodeFlow = 0.0;
   double sumLinkFlow = 0.0;
-  unsigned int linkIndex = 0;
-  auto featureLinkIndex = bipartiteLinkStartIndex;
 
-  network.forEachLink([&](unsigned int srcIdx, unsigned int, double, double& flow) {
-    if (network.isBipartite() && network.nodeId(srcIdx) >= network.bipartiteStartId()) {
-      flow = flowLinks[featureLinkIndex++].flow;
-    } else {
-      flow = flowLinks[linkIndex++].flow;
-    }
+  // flowLinks is in CSR order, so its flow is the network's link flow as is. The
+  // links are done with after this, so hand it over instead of copying.
+  network.m_linkFlows = std::move(flowLinks.flow);
+  flowLinks = {};
+  for (const auto flow : network.m_linkFlows) {
     sumLinkFlow += flow;
-  });
+  }
 
   double fractionIntraFlow = config.isMultilayerNetwork() && config.regularized ? 1 : 0;
 
   sumTeleFlow = 0.0;
 
+  // The nodes are in CSR order, so the CSR index is a running count.
+  unsigned int csrIndex = 0;
   for (auto& nodeIt : network.m_nodes) {
     auto& node = nodeIt.second;
-    const auto nodeIndex = nodeIndexMap[node.id];
+    const auto srcIdx = csrIndex++;
+    const auto nodeIndex = csrNodeIndex[srcIdx];
     node.flow = nodeFlow[nodeIndex];
     node.weight = nodeTeleportWeights[nodeIndex];
     node.teleFlow = !nodeTeleportFlow.empty() ? nodeTeleportFlow[nodeIndex] : nodeFlow[nodeIndex] * (nodeOutDegree[nodeIndex] == 0 ? 1 : config.teleportationProbability);
@@ -1480,7 +1800,6 @@ void FlowCalculator::finalize(StateNetwork& network, const Config& config, bool
 
       // Remove self-link flow
       unsigned int norm = config.isUndirectedFlow() ? 2 : 1;
-      const auto srcIdx = network.indexOfId(node.id);
       for (unsigned int e = network.m_linkOffsets[srcIdx]; e < network.m_linkOffsets[srcIdx + 1]; ++e) {
         if (network.m_linkTargets[e] == srcIdx) { // self-link: target index == source index
           node.enterFlow -= network.m_linkFlows[e] / norm;
@@ -1506,10 +1825,10 @@ void FlowCalculator::finalize(StateNetwork& network, const Config& config, bool
           sumDanglingFlow += nodeFlow[i];
         }
       }
+      unsigned int srcIdx = 0;
       for (auto& nodeIt : network.m_nodes) {
         auto& node = nodeIt.second;
-        const auto sourceIndex = nodeIndexMap[node.id];
-        const auto srcIdx = network.indexOfId(node.id);
+        const auto sourceIndex = csrNodeIndex[srcIdx];
         double danglingFlow = network.isDangling(srcIdx) ? node.flow : 0.0;
         if (config.recordedTeleportation) {
           // Don't let self-teleportation add to the enter/exit flow (i.e. multiply with (1.0 - node.data.teleportWeight))
@@ -1517,38 +1836,79 @@ void FlowCalculator::finalize(StateNetwork& network, const Config& config, bool
           enterFlow[sourceIndex] += (alpha * (1.0 - node.flow) + (1 - alpha) * (sumDanglingFlow - danglingFlow)) * node.weight;
         }
         for (unsigned int e = network.m_linkOffsets[srcIdx]; e < network.m_linkOffsets[srcIdx + 1]; ++e) {
-          const auto targetIndex = nodeIndexMap[network.nodeId(network.m_linkTargets[e])];
+          const auto targetIndex = csrNodeIndex[network.m_linkTargets[e]];
           exitFlow[sourceIndex] += network.m_linkFlows[e];
           enterFlow[targetIndex] += network.m_linkFlows[e];
         }
+        ++srcIdx;
       }
     }
   }
 
   // Save enter/exit flow on nodes
   if (!enterFlow.empty()) {
+    csrIndex = 0;
     for (auto& nodeIt : network.m_nodes) {
       auto& node = nodeIt.second;
-      const auto nodeIndex = nodeIndexMap[node.id];
+      const auto nodeIndex = csrNodeIndex[csrIndex++];
       node.enterFlow = enterFlow[nodeIndex];
       node.exitFlow = exitFlow[nodeIndex];
     }
   }
 
-  Console console;
-  console.section("Flow");
-  console.metric("Model", io::stringify(config.flowModel));
-  console.metric("Method", m_flowMethod.empty() ? "standard" : m_flowMethod);
-  if (!m_teleportation.empty())
-    console.metric("Teleportation", m_teleportation);
-  if (m_havePageRank) {
-    console.metric(m_pageRankConverged ? "PageRank" : "PageRank warning",
-                   fmt::format(FMT_STRING("{} iterations, error {}"), m_pageRankIterations, io::toPrecision(m_pageRankError)));
-  }
-  for (const auto& note : m_flowNotes)
-    console.status("Note", note);
-  console.metric("Node flow sum", io::toPrecision(sumNodeFlow));
-  console.metric("Link flow sum", io::toPrecision(sumLinkFlow));
+  m_report.sumNodeFlow = sumNodeFlow;
+  m_report.sumLinkFlow = sumLinkFlow;
+}
+
+namespace {
+
+  void printFlowReport(const StateNetwork& network, const Config& config, const detail::FlowReport& report)
+  {
+    Console console;
+    console.section("Flow");
+    console.metric("Model", io::stringify(config.flowModel));
+    console.metric("Method", report.method.empty() ? "standard" : report.method);
+    if (!report.teleportation.empty())
+      console.metric("Teleportation", report.teleportation);
+    if (network.haveFlowConvergence()) {
+      console.metric(network.flowConverged() ? "PageRank" : "PageRank warning",
+                     fmt::format(FMT_STRING("{} iterations, error {}"), network.flowIterations(), io::toPrecision(network.flowError())));
+    }
+    for (const auto& note : report.notes)
+      console.status("Note", note);
+    console.metric("Node flow sum", io::toPrecision(report.sumNodeFlow));
+    console.metric("Link flow sum", io::toPrecision(report.sumLinkFlow));
+  }
+
+} // namespace
+
+void calculateFlow(StateNetwork& network, const Config& config)
+{
+  network.m_flowCacheFile.clear();
+  network.m_flowCacheHit = false;
+  if (config.flowCacheDir.empty()) {
+    printFlowReport(network, config, FlowCalculator(network, config).report());
+    return;
+  }
+
+  FlowCache cache(config.flowCacheDir, network, config);
+  detail::FlowReport report;
+  if (cache.read(network, report)) {
+    report.notes.push_back(fmt::format(FMT_STRING("Read from flow cache {}"), cache.filename()));
+    printFlowReport(network, config, report);
+    return;
+  }
+
+  report = FlowCalculator(network, config).report();
+  network.m_flowCacheFile = cache.filename();
+  // The cache only saves time on the next run; failing to write it must not fail this one.
+  try {
+    cache.write(network, report);
+    report.notes.push_back(fmt::format(FMT_STRING("Wrote flow cache {}"), cache.filename()));
+  } catch (const std::exception& e) {
+    Console::warn(0, "{} Continuing without the flow cache.", e.what());
+  }
+  printFlowReport(network, config, report);
 }
 
 } // namespace infomap
@@ -10,7 +10,7 @@
 #ifndef FLOW_CALCULATOR_H_
 #define FLOW_CALCULATOR_H_
 
-#include <unordered_map>
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -20,10 +20,42 @@ struct Config;
 class StateNetwork;
 
 namespace detail {
-  struct FlowLink {
-    unsigned int source;
-    unsigned int target;
-    double flow;
+  //! The links as parallel arrays, in the network's CSR order. That is source
+  //! order in FlowCalculator's node indexing too, so a pass over the links reads
+  //! each array front to back, and a pass that needs only the flow and one
+  //! endpoint leaves the other array alone.
+  struct FlowLinks {
+    std::vector<unsigned int> source;
+    std::vector<unsigned int> target;
+    std::vector<double> flow;
+
+    std::size_t size() const noexcept { return flow.size(); }
+
+    void resize(std::size_t numLinks)
+    {
+      source.resize(numLinks, 0);
+      target.resize(numLinks, 0);
+      flow.resize(numLinks, 0.0);
+    }
+
+    //! fn(source, target, flow) for each link in order, flow writable.
+    template <typename Fn>
+    void forEach(Fn&& fn)
+    {
+      const auto numLinks = size();
+      for (std::size_t k = 0; k < numLinks; ++k)
+        fn(source[k], target[k], flow[k]);
+    }
+  };
+
+  //! What the Flow section of the console shows, kept apart from the network so
+  //! a flow read from --flow-cache can report how it was first calculated.
+  struct FlowReport {
+    std::string method;
+    std::string teleportation;
+    std::vector<std::string> notes;
+    double sumNodeFlow = 0.0;
+    double sumLinkFlow = 0.0;
   };
 } // namespace detail
 
@@ -34,6 +66,8 @@ class FlowCalculator {
 public:
   FlowCalculator(StateNetwork&, const Config&);
 
+  const detail::FlowReport& report() const { return m_report; }
+
 private:
   void calcUndirectedFlow() noexcept;
   void calcDirectedFlow(const StateNetwork&, const Config&) noexcept;
@@ -51,8 +85,18 @@ private:
 
   void addFlowNote(const std::string& note);
   void recordPageRank(unsigned int iterations, double error, bool converged) noexcept;
+  void recordExtrapolations(const Config&, unsigned int extrapolations);
+
+  //! Seed nodeFlow with the network's initial flow, if any. If it misses nodes,
+  //! take the cold start's first step before, for them to keep. Returns that
+  //! step's error, or 0 without it.
+  template <typename ColdStep>
+  double warmStart(const StateNetwork&, ColdStep&& coldStep);
+  void recordWarmStart(const Config&, double coldError, const std::vector<double>& errors);
+  void addUnrecordedTeleportation(double alpha) noexcept;
 
   double accumulateDanglingRank() const noexcept;
+  double sumOverDanglingNodes(const std::vector<double>& values) const noexcept;
 
   unsigned int numNodes;
   //! One past the last dangling node, for the directed model's dangling-first
@@ -65,7 +109,9 @@ private:
   double sumWeightedDegree = 0;
   double sumTeleFlow = 0;
 
-  std::unordered_map<unsigned int, unsigned int> nodeIndexMap;
+  //! The FlowCalculator index of each network node, by CSR index. The identity,
+  //! except for the directed model's dangling-first ordering.
+  std::vector<unsigned int> csrNodeIndex;
   std::vector<double> nodeFlow;
   std::vector<double> nodeTeleportWeights;
   std::vector<double> nodeTeleportFlow;
@@ -77,22 +123,21 @@ private:
   //! Bipartite input keeps the network's node order, because the feature side is
   //! identified by an index range, so the dangling-first ordering is unavailable.
   std::vector<unsigned int> danglingIndices;
-  using FlowLink = detail::FlowLink;
-  std::vector<FlowLink> flowLinks;
+  detail::FlowLinks flowLinks;
 
-  std::string m_flowMethod;
-  std::string m_teleportation;
-  std::vector<std::string> m_flowNotes;
+  detail::FlowReport m_report;
   unsigned int m_pageRankIterations = 0;
   double m_pageRankError = 0.0;
   bool m_havePageRank = false;
   bool m_pageRankConverged = true;
+  bool m_usedInitialFlow = false;
+  unsigned int m_warmStartNodes = 0;
+  unsigned int m_warmStartColdSteps = 0;
 };
 
-inline void calculateFlow(StateNetwork& network, const Config& config)
-{
-  FlowCalculator(network, config);
-}
+//! Calculate the flow, or read it from config.flowCacheDir when a cache file
+//! for this network and these flow settings exists, and print the Flow section.
+void calculateFlow(StateNetwork&, const Config&);
 
 } // namespace infomap
 
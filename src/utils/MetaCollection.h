@@ -122,7 +122,7 @@ public:
     }
   }
 
-  double calculateEntropy()
+  double calculateEntropy() const
   {
     double metaCodelength = 0.0;
     for (auto& it : m_metaToFlowCount) {
@@ -131,6 +131,48 @@ public:
     return m_total.flow * metaCodelength;
   }
 
+  /**
+   * Entropy as if other had been added (sign > 0) or removed (sign < 0),
+   * without modifying this collection. Walks both sorted maps once, with the
+   * same sums in the same order as add() or remove() followed by
+   * calculateEntropy(), so the result is identical.
+   */
+  double calculateEntropyWith(const MetaCollection& other, int sign) const
+  {
+    FlowCount total = m_total;
+    for (auto& it : other) {
+      if (sign > 0)
+        total += it.second;
+      else
+        total -= it.second;
+    }
+
+    double metaCodelength = 0.0;
+    auto it = m_metaToFlowCount.begin();
+    auto otherIt = other.begin();
+    while (it != m_metaToFlowCount.end() || otherIt != other.end()) {
+      FlowCount flowCount;
+      if (otherIt == other.end() || (it != m_metaToFlowCount.end() && it->first < otherIt->first)) {
+        flowCount = it->second;
+        ++it;
+      } else {
+        if (it != m_metaToFlowCount.end() && it->first == otherIt->first) {
+          flowCount = it->second;
+          ++it;
+        }
+        if (sign > 0)
+          flowCount += otherIt->second;
+        else
+          flowCount -= otherIt->second;
+        ++otherIt;
+      }
+      // remove() erases emptied entries
+      if (!flowCount.empty())
+        metaCodelength -= infomath::plogp(flowCount.flow / total.flow);
+    }
+    return total.flow * metaCodelength;
+  }
+
   void clear()
   {
     m_total.reset();
@@ -193,10 +193,19 @@ public:
    */
   void getRandomizedIndexVector(std::vector<unsigned int>& randomOrder)
   {
-    unsigned int size = randomOrder.size();
     std::iota(randomOrder.begin(), randomOrder.end(), 0u);
+    shuffle(randomOrder);
+  }
+
+  /**
+   * Randomly permute the input vector in place
+   */
+  template <typename T>
+  void shuffle(std::vector<T>& values)
+  {
+    unsigned int size = values.size();
     for (unsigned int i = 0; i < size; ++i)
-      std::swap(randomOrder[i], randomOrder[i + randInt(0, size - i - 1)]);
+      std::swap(values[i], values[i + randInt(0, size - i - 1)]);
   }
 };
 
@@ -27,6 +27,7 @@ struct TrialTimingRecord {
   double codelength = 0.0;
   unsigned int topModules = 0;
   unsigned int numLevels = 0;
+  bool abandoned = false; // stopped early by --prune-trials
   bool valid = false;
 };
 
@@ -103,7 +104,7 @@ public:
     m_trials.assign(numTrials, TrialTimingRecord());
   }
 
-  void recordTrial(unsigned int trialIndex, int thread, unsigned long seed, double timeSec, double codelength, unsigned int topModules, unsigned int numLevels)
+  void recordTrial(unsigned int trialIndex, int thread, unsigned long seed, double timeSec, double codelength, unsigned int topModules, unsigned int numLevels, bool abandoned = false)
   {
     std::lock_guard<std::mutex> lock(m_mutex);
     if (trialIndex >= m_trials.size()) {
@@ -117,6 +118,7 @@ public:
     record.codelength = codelength;
     record.topModules = topModules;
     record.numLevels = numLevels;
+    record.abandoned = abandoned;
     record.valid = true;
     m_trials[trialIndex] = record;
   }
@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <cmath>
 #include <fstream>
+#include <random>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -203,6 +204,115 @@ inline void checkRunSanity(InfomapWrapper& im)
   CHECK(partitionIds == coveredIds);
 }
 
+// A state network above the inner-parallelization size threshold. Each physical
+// node has four state nodes, one per "layer", and the layers group the physical
+// nodes into overlapping rings, so the states of one physical node end up in
+// different modules and the physical-node codebook terms are exercised.
+inline void addOverlappingStateNetwork(InfomapWrapper& im, unsigned int numPhysicalNodes = 3000)
+{
+  constexpr unsigned int statesPerPhysicalNode = 4;
+  constexpr unsigned int groupSize = 5;
+  const auto stateId = [](unsigned int physId, unsigned int layer) { return physId * statesPerPhysicalNode + layer; };
+  for (unsigned int physId = 0; physId < numPhysicalNodes; ++physId) {
+    for (unsigned int layer = 0; layer < statesPerPhysicalNode; ++layer) {
+      im.addStateNode(stateId(physId, layer), physId);
+    }
+  }
+  for (unsigned int physId = 0; physId < numPhysicalNodes; ++physId) {
+    for (unsigned int layer = 0; layer < statesPerPhysicalNode; ++layer) {
+      // Odd layers shift the groups by half a group.
+      const unsigned int shift = (layer % 2) * (groupSize / 2);
+      const unsigned int groupStart = ((physId + shift) / groupSize) * groupSize;
+      for (unsigned int k = 0; k < groupSize; ++k) {
+        const unsigned int other = (groupStart + k + numPhysicalNodes - shift) % numPhysicalNodes;
+        if (other != physId)
+          im.addLink(stateId(physId, layer), stateId(other, layer), 1.0);
+      }
+      im.addLink(stateId(physId, layer), stateId((physId + 1) % numPhysicalNodes, (layer + 1) % statesPerPhysicalNode), 0.2);
+    }
+  }
+}
+
+// A multilayer network above the inner-parallelization size threshold: four
+// layers over the same physical nodes, each with dense groups of five (shifted
+// by half a group on odd layers) and a weak ring link per node.
+inline void addShiftedGroupMultilayerNetwork(InfomapWrapper& im, unsigned int numPhysicalNodes = 3000)
+{
+  constexpr unsigned int numLayers = 4;
+  constexpr unsigned int groupSize = 5;
+  for (unsigned int layer = 1; layer <= numLayers; ++layer) {
+    const unsigned int shift = (layer % 2) * (groupSize / 2);
+    for (unsigned int physId = 0; physId < numPhysicalNodes; ++physId) {
+      const unsigned int groupStart = ((physId + shift) / groupSize) * groupSize;
+      for (unsigned int k = 0; k < groupSize; ++k) {
+        const unsigned int other = (groupStart + k + numPhysicalNodes - shift) % numPhysicalNodes;
+        if (other != physId)
+          im.addMultilayerIntraLink(layer, physId + 1, other + 1, 1.0);
+      }
+      im.addMultilayerIntraLink(layer, physId + 1, (physId + 1) % numPhysicalNodes + 1, 0.2);
+    }
+  }
+}
+
+// A first-order network above the inner-parallelization size threshold, with
+// one meta-data category per node. Nodes form dense groups of five joined in a
+// ring, and the categories cut across the groups so the meta term never
+// vanishes and every move changes it.
+inline void addMetaDataGroupNetwork(InfomapWrapper& im, unsigned int numNodes = 12000)
+{
+  constexpr unsigned int groupSize = 5;
+  constexpr int numCategories = 3;
+  for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId) {
+    const unsigned int groupStart = (nodeId / groupSize) * groupSize;
+    for (unsigned int k = 0; k < groupSize; ++k) {
+      const unsigned int other = groupStart + k;
+      if (other != nodeId && other < numNodes)
+        im.addLink(nodeId, other, 1.0);
+    }
+    im.addLink(nodeId, (nodeId + groupSize) % numNodes, 0.2);
+    im.network().addMetaData(nodeId, static_cast<int>(nodeId % numCategories));
+  }
+}
+
+// A first-order network above the inner-parallelization size threshold whose
+// groups of eight are blurred by random links, so the serial and the parallel
+// sweep settle on different partitions. Drawn from std::minstd_rand directly,
+// whose sequence the standard fixes, so the network is the same everywhere.
+inline void addNoisyGroupNetwork(InfomapWrapper& im, unsigned int numNodes = 12000)
+{
+  constexpr unsigned int groupSize = 8;
+  std::minstd_rand rand(12345);
+  for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId) {
+    const unsigned int groupStart = (nodeId / groupSize) * groupSize;
+    for (unsigned int k = 0; k < 3; ++k) {
+      const unsigned int other = groupStart + static_cast<unsigned int>(rand() % groupSize);
+      if (other != nodeId && other < numNodes)
+        im.addLink(nodeId, other, 1.0);
+    }
+    im.addLink(nodeId, static_cast<unsigned int>(rand() % numNodes), 1.0);
+  }
+}
+
+// A first-order network whose two-level partition has more modules than the
+// inner-parallelization size threshold: cliques of four, each linked to the
+// next in a ring and to one random node, so the super-module search runs on a
+// super network above the threshold.
+inline void addCliqueRingNetwork(InfomapWrapper& im, unsigned int numNodes = 48000)
+{
+  constexpr unsigned int cliqueSize = 4;
+  const unsigned int numCliques = numNodes / cliqueSize;
+  std::minstd_rand rand(54321);
+  for (unsigned int clique = 0; clique < numCliques; ++clique) {
+    const unsigned int first = clique * cliqueSize;
+    for (unsigned int i = 0; i < cliqueSize; ++i) {
+      for (unsigned int j = i + 1; j < cliqueSize; ++j)
+        im.addLink(first + i, first + j, 1.0);
+    }
+    im.addLink(first, ((clique + 1) % numCliques) * cliqueSize + 1, 0.3);
+    im.addLink(first + 2, static_cast<unsigned int>(rand() % (numCliques * cliqueSize)), 0.05);
+  }
+}
+
 } // namespace test
 } // namespace infomap
 
@@ -266,6 +266,16 @@ TEST_CASE("Config rejects converge combined with distributed sharding [fast][cor
   CHECK_THROWS_AS(Config("input.net --silent --no-file-output --converge --trial-results shard.json", true), std::runtime_error);
 }
 
+TEST_CASE("Config parses and validates the inner parallel strategy [fast][core][config][cli]")
+{
+  CHECK(Config("input.net --silent --no-file-output", true).innerParallelStrategy == "proposals");
+  CHECK(Config("input.net --silent --no-file-output --inner-parallel-strategy coloring", true).innerParallelStrategy == "coloring");
+  CHECK_THROWS_WITH_AS(
+      Config("input.net --silent --no-file-output --inner-parallel-strategy greedy", true),
+      "--inner-parallel-strategy must be 'proposals' or 'coloring', got 'greedy'",
+      std::runtime_error);
+}
+
 TEST_CASE("Config parses run report flags [fast][core][config][cli]")
 {
   const Config config("input.net --silent --no-file-output --timing-json timing.json --summary-json summary.json --memory-report --manifest-json manifest.json", true);
@@ -323,7 +333,7 @@ TEST_CASE("Config parses batch output safety flags [fast][core][config][cli]")
 TEST_CASE("Config fingerprint ignores presentation output options [fast][core][config][cli]")
 {
   const Config base("input.net --silent --no-file-output --seed 7 --num-trials 2 --flow-model directed", true);
-  const Config cosmetic("input.net --pretty --verbose --no-file-output --seed 7 --num-trials 2 --flow-model directed --timing-json timing.json --summary-json summary.json", true);
+  const Config cosmetic("input.net --pretty --verbose --no-file-output --seed 7 --num-trials 2 --flow-model directed --timing-json timing.json --summary-json summary.json --flow-cache flow-cache", true);
   const Config changed("input.net --silent --no-file-output --seed 8 --num-trials 2 --flow-model directed", true);
 
   CHECK(infomap::configFingerprint(base) == infomap::configFingerprint(cosmetic));
@@ -860,6 +870,22 @@ TEST_CASE("Config defaults flow iteration limits and tolerance when flags are ab
   CHECK(config.flowTolerance == doctest::Approx(1e-15));
 }
 
+TEST_CASE("Config parses and validates the flow acceleration [fast][core][config][cli]")
+{
+  CHECK(Config("input.net --silent --no-file-output", true).flowAcceleration == "none");
+  CHECK(Config("input.net --silent --no-file-output --flow-acceleration quadratic", true).flowAcceleration == "quadratic");
+  CHECK_THROWS_WITH_AS(
+      Config("input.net --silent --no-file-output --flow-acceleration aitken", true),
+      "--flow-acceleration must be 'none' or 'quadratic', got 'aitken'",
+      std::runtime_error);
+}
+
+TEST_CASE("Config parses the initial flow file [fast][core][config][cli]")
+{
+  CHECK(Config("input.net --silent --no-file-output", true).initialFlowFile.empty());
+  CHECK(Config("input.net --silent --no-file-output --initial-flow previous.tree", true).initialFlowFile == "previous.tree");
+}
+
 TEST_CASE("Config rejects non-numeric, non-auto --num-threads [fast][core][config][cli]")
 {
   CHECK_THROWS(Config("input.net --silent --no-file-output --num-threads banana", true));
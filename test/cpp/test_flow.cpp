@@ -321,6 +321,74 @@ FlowRunResult runDirectedFixture(const std::string& extraFlags)
   };
 }
 
+FlowRunResult runOverlappingStateNetwork(const std::string& extraFlags)
+{
+  InfomapWrapper im(infomap::test::defaultFlags("--directed --two-level " + extraFlags));
+  infomap::test::addOverlappingStateNetwork(im);
+
+  im.run();
+
+  infomap::test::checkRunSanity(im);
+  FlowRunResult result;
+  result.modules = im.getModules(1, true);
+  result.partition = infomap::test::canonicalPartition(result.modules);
+  result.codelength = im.codelength();
+  result.indexCodelength = im.getIndexCodelength();
+  result.numTopModules = im.numTopModules();
+  return result;
+}
+
+FlowRunResult runMetaDataGroupNetwork(const std::string& extraFlags)
+{
+  InfomapWrapper im(infomap::test::defaultFlags("--two-level " + extraFlags));
+  infomap::test::addMetaDataGroupNetwork(im);
+
+  im.run();
+
+  infomap::test::checkRunSanity(im);
+  FlowRunResult result;
+  result.modules = im.getModules();
+  result.partition = infomap::test::canonicalPartition(result.modules);
+  result.codelength = im.codelength();
+  result.indexCodelength = im.getIndexCodelength();
+  result.numTopModules = im.numTopModules();
+  return result;
+}
+
+FlowRunResult runNoisyGroupNetwork(const std::string& extraFlags)
+{
+  InfomapWrapper im(infomap::test::defaultFlags(extraFlags));
+  infomap::test::addNoisyGroupNetwork(im);
+
+  im.run();
+
+  infomap::test::checkRunSanity(im);
+  FlowRunResult result;
+  result.modules = im.getModules();
+  result.partition = infomap::test::canonicalPartition(result.modules);
+  result.codelength = im.codelength();
+  result.indexCodelength = im.getIndexCodelength();
+  result.numTopModules = im.numTopModules();
+  return result;
+}
+
+FlowRunResult runCliqueRingNetwork(const std::string& extraFlags)
+{
+  InfomapWrapper im(infomap::test::defaultFlags(extraFlags));
+  infomap::test::addCliqueRingNetwork(im);
+
+  im.run();
+
+  infomap::test::checkRunSanity(im);
+  FlowRunResult result;
+  result.modules = im.getModules();
+  result.partition = infomap::test::canonicalPartition(result.modules);
+  result.codelength = im.codelength();
+  result.indexCodelength = im.getIndexCodelength();
+  result.numTopModules = im.numTopModules();
+  return result;
+}
+
 void checkInnerParallelPartitionCodelength(const std::string& extraFlags, const std::string& clusterPath)
 {
   const auto result = runDirectedFixture("--inner-parallelization " + extraFlags);
@@ -470,7 +538,7 @@ TEST_CASE("Regularized multilayer matchable state-id flow matches analytic prior
   checkRegularizedMultilayerFlow(im, analyticRegularizedMultilayerFlow(intraLinks));
 }
 
-TEST_CASE("Inner parallelization with regularized multilayer input falls back to stable serial optimization [fast][core][flow][openmp]")
+TEST_CASE("Inner parallelization with small regularized multilayer input matches the serial sweep [fast][core][flow][openmp]")
 {
 #ifdef _OPENMP
   ScopedOmpThreadCount ompThreads(8);
@@ -512,6 +580,34 @@ TEST_CASE("Inner parallelization with regularized multilayer input falls back to
   infomap::test::checkApproxCodelength(requestedInner.codelength, serial.codelength, 1e-12);
   infomap::test::checkApproxCodelength(requestedInner.indexCodelength, serial.indexCodelength, 1e-12);
 }
+
+TEST_CASE("Inner parallelization with regularized multilayer input stays close to the serial sweep [core][flow][openmp]")
+{
+  auto runRegularizedMultilayer = [](const std::string& extraFlags) {
+    InfomapWrapper im(infomap::test::defaultFlags("--directed --regularized --two-level " + extraFlags));
+    infomap::test::addShiftedGroupMultilayerNetwork(im);
+
+    im.run();
+
+    infomap::test::checkRunSanity(im);
+    FlowRunResult result;
+    result.modules = im.getModules(1, true);
+    result.partition = infomap::test::canonicalPartition(result.modules);
+    result.codelength = im.codelength();
+    result.numTopModules = im.numTopModules();
+    return result;
+  };
+
+  const auto serial = runRegularizedMultilayer("");
+  const auto inner = runRegularizedMultilayer("--inner-parallelization --num-threads 4");
+
+  CHECK(inner.numTopModules > 1);
+  CHECK(inner.codelength < serial.codelength * 1.02);
+
+  const auto again = runRegularizedMultilayer("--inner-parallelization --num-threads 4");
+  CHECK(again.partition == inner.partition);
+  CHECK(again.codelength == inner.codelength);
+}
 #else
 TEST_CASE("Regularized multilayer flow requires compile-time feature [fast][core][flow]")
 {
@@ -590,7 +686,7 @@ TEST_CASE("Inner parallelization is deterministic for a fixed seed and thread co
   CHECK(first.indexCodelength == doctest::Approx(second.indexCodelength));
 }
 
-TEST_CASE("Inner parallelization with meta data falls back to stable serial optimization [fast][core][flow][openmp]")
+TEST_CASE("Inner parallelization with meta data remains runnable on the states fixture [fast][core][flow][openmp]")
 {
 #ifdef _OPENMP
   ScopedOmpThreadCount ompThreads(8);
@@ -613,7 +709,20 @@ TEST_CASE("Inner parallelization with meta data falls back to stable serial opti
   }
 }
 
-TEST_CASE("Inner parallelization with memory input falls back to stable serial optimization [fast][core][flow][openmp]")
+TEST_CASE("Inner parallelization with meta data stays close to the serial sweep [core][flow][openmp]")
+{
+  const auto serial = runMetaDataGroupNetwork("");
+  const auto inner = runMetaDataGroupNetwork("--inner-parallelization --num-threads 4");
+
+  CHECK(inner.numTopModules > 1);
+  CHECK(inner.codelength < serial.codelength * 1.02);
+
+  const auto again = runMetaDataGroupNetwork("--inner-parallelization --num-threads 4");
+  CHECK(again.partition == inner.partition);
+  CHECK(again.codelength == inner.codelength);
+}
+
+TEST_CASE("Inner parallelization with memory input remains runnable on the states fixture [fast][core][flow][openmp]")
 {
 #ifdef _OPENMP
   ScopedOmpThreadCount ompThreads(8);
@@ -630,6 +739,250 @@ TEST_CASE("Inner parallelization with memory input falls back to stable serial o
   CHECK(im.codelength() >= im.getIndexCodelength());
 }
 
+TEST_CASE("Inner parallelization with memory input stays close to the serial sweep [core][flow][openmp]")
+{
+  const auto serial = runOverlappingStateNetwork("");
+  // An explicit budget, since the run otherwise resolves one from the CPUs
+  // available and may land on a single thread and the serial sweep.
+  const auto inner = runOverlappingStateNetwork("--inner-parallelization --num-threads 4");
+
+  CHECK(inner.numTopModules > 1);
+  CHECK(inner.codelength < serial.codelength * 1.02);
+
+  const auto again = runOverlappingStateNetwork("--inner-parallelization --num-threads 4");
+  CHECK(again.partition == inner.partition);
+  CHECK(again.codelength == inner.codelength);
+}
+
+TEST_CASE("Deterministic inner parallelization is independent of the thread count [core][flow][openmp]")
+{
+  // Hierarchical, so the recursive partitioning runs as well. With a single
+  // thread the default mode would fall back to the serial sweep; --deterministic
+  // keeps the parallel one, so every budget takes the same moves.
+  const auto oneThread = runNoisyGroupNetwork("--deterministic --inner-parallelization --num-threads 1");
+  const auto twoThreads = runNoisyGroupNetwork("--deterministic --inner-parallelization --num-threads 2");
+  const auto fourThreads = runNoisyGroupNetwork("--deterministic --inner-parallelization --num-threads 4");
+
+  CHECK(oneThread.numTopModules > 1);
+  CHECK(twoThreads.modules == oneThread.modules);
+  CHECK(twoThreads.codelength == oneThread.codelength);
+  CHECK(fourThreads.modules == oneThread.modules);
+  CHECK(fourThreads.codelength == oneThread.codelength);
+}
+
+TEST_CASE("Deterministic parallel trials are independent of the thread count [core][flow][openmp]")
+{
+  // Trial workers keep the parallel sweep under --deterministic, so a trial
+  // takes the same moves whether it runs alone or next to other workers.
+  const std::string flags = "--two-level --deterministic --inner-parallelization --parallel-trials --num-trials 3";
+  const auto oneThread = runNoisyGroupNetwork(flags + " --num-threads 1");
+  const auto threeThreads = runNoisyGroupNetwork(flags + " --num-threads 3");
+
+  CHECK(threeThreads.modules == oneThread.modules);
+  CHECK(threeThreads.codelength == oneThread.codelength);
+  CHECK(threeThreads.indexCodelength == oneThread.indexCodelength);
+
+  // And the same moves as the serial trial loop.
+  const auto serialTrials = runNoisyGroupNetwork("--two-level --deterministic --inner-parallelization --num-trials 3 --num-threads 2");
+  CHECK(serialTrials.modules == oneThread.modules);
+  CHECK(serialTrials.codelength == oneThread.codelength);
+}
+
+TEST_CASE("Directed flow is independent of the thread count [core][flow][openmp]")
+{
+  // Several blocks of nodes, so the power iterations spread over the threads
+  // and the per-block sums are added up from more than one partial.
+  const auto leafFlows = [](const std::string& flags) {
+    InfomapWrapper im(infomap::test::defaultFlags("--directed --no-infomap " + flags));
+    infomap::test::addNoisyGroupNetwork(im, 40000);
+    im.run();
+    std::map<unsigned int, double> flows;
+    for (auto it = im.iterLeafNodes(); !it.isEnd(); ++it)
+      flows[it->physicalId] = it->data.flow;
+    return flows;
+  };
+
+  const auto oneThread = leafFlows("--num-threads 1");
+  const auto fourThreads = leafFlows("--num-threads 4");
+
+  CHECK(oneThread.size() == 40000);
+  CHECK(fourThreads == oneThread);
+}
+
+TEST_CASE("Coloring sweep is independent of the thread count and close to the proposal sweep [core][flow][openmp]")
+{
+  // Nodes of one color move together with atomic module-flow updates; under
+  // --deterministic those run on one thread, so the sums, and with them every
+  // later move, do not depend on --num-threads.
+  const std::string flags = "--two-level --deterministic --inner-parallelization --inner-parallel-strategy coloring";
+  const auto oneThread = runNoisyGroupNetwork(flags + " --num-threads 1");
+  const auto fourThreads = runNoisyGroupNetwork(flags + " --num-threads 4");
+
+  CHECK(oneThread.numTopModules > 1);
+  CHECK(fourThreads.modules == oneThread.modules);
+  CHECK(fourThreads.codelength == oneThread.codelength);
+
+  // A different engine, so a different partition, but not a worse kind of one.
+  const auto proposals = runNoisyGroupNetwork("--two-level --deterministic --inner-parallelization --num-threads 1");
+  INFO("coloring=" << oneThread.codelength << " proposals=" << proposals.codelength);
+  CHECK(oneThread.codelength == doctest::Approx(proposals.codelength).epsilon(0.01));
+}
+
+TEST_CASE("Coloring sweep falls back to proposals for coupled objectives [core][flow][openmp]")
+{
+  // Recorded teleportation couples nodes without a link between them, which
+  // the coloring cannot separate, so the run must equal the proposal sweep.
+  const std::string flags = "--two-level --directed --recorded-teleportation --deterministic --inner-parallelization --num-threads 2";
+  const auto coloring = runNoisyGroupNetwork(flags + " --inner-parallel-strategy coloring");
+  const auto proposals = runNoisyGroupNetwork(flags);
+
+  CHECK(coloring.modules == proposals.modules);
+  CHECK(coloring.codelength == proposals.codelength);
+}
+
+TEST_CASE("Active-set sweeps find a partition as good as full sweeps [core][flow]")
+{
+  // Nodes marked during a sweep wait for the next one, so the moves differ
+  // from the full sweep, but not the quality of what they settle on.
+  const auto fullSweeps = runNoisyGroupNetwork("--two-level --num-threads 1");
+  const auto activeSet = runNoisyGroupNetwork("--two-level --num-threads 1 --active-set");
+  INFO("active set=" << activeSet.codelength << " full sweeps=" << fullSweeps.codelength);
+  CHECK(activeSet.numTopModules > 1);
+  CHECK(activeSet.codelength == doctest::Approx(fullSweeps.codelength).epsilon(0.01));
+}
+
+TEST_CASE("Active-set parallel sweeps are independent of the thread count [core][flow][openmp]")
+{
+  const std::string flags = "--two-level --deterministic --inner-parallelization --active-set";
+  const auto oneThread = runNoisyGroupNetwork(flags + " --num-threads 1");
+  const auto fourThreads = runNoisyGroupNetwork(flags + " --num-threads 4");
+
+  CHECK(oneThread.numTopModules > 1);
+  CHECK(fourThreads.modules == oneThread.modules);
+  CHECK(fourThreads.codelength == oneThread.codelength);
+
+  const auto fullSweeps = runNoisyGroupNetwork("--two-level --deterministic --inner-parallelization --num-threads 1");
+  CHECK(oneThread.codelength == doctest::Approx(fullSweeps.codelength).epsilon(0.01));
+}
+
+TEST_CASE("Coarse-tune sub-runs are independent of the thread count [core][flow][openmp]")
+{
+  // The coarse tune partitions every module as its own task and numbers the
+  // sub-modules afterwards, so the thread count must not change the result.
+  // Several tune iterations, so coarse tunes on top of coarse tunes are covered.
+  const std::string flags = "--tune-iteration-limit 4";
+  const auto oneThread = runNoisyGroupNetwork(flags + " --num-threads 1");
+  const auto fourThreads = runNoisyGroupNetwork(flags + " --num-threads 4");
+
+  CHECK(oneThread.numTopModules > 1);
+  CHECK(fourThreads.modules == oneThread.modules);
+  CHECK(fourThreads.codelength == oneThread.codelength);
+  CHECK(fourThreads.indexCodelength == oneThread.indexCodelength);
+}
+
+TEST_CASE("Recycled sub-Infomaps give the same result as fresh ones [core][flow]")
+{
+  // Sub-Infomaps go back to a per-thread pool when disposed, so later runs in
+  // the same process reuse instances left by earlier ones, including instances
+  // built for another objective. The runs in between use the memory and the
+  // meta-data objective, so the second run also recycles instances whose
+  // optimizer has to be replaced.
+  const auto first = runNoisyGroupNetwork("");
+  const auto stateRun = runOverlappingStateNetwork("");
+  const auto metaRun = runMetaDataGroupNetwork("");
+  const auto second = runNoisyGroupNetwork("");
+
+  CHECK(stateRun.numTopModules > 1);
+  CHECK(metaRun.numTopModules > 1);
+  CHECK(second.modules == first.modules);
+  CHECK(second.codelength == first.codelength);
+  CHECK(second.indexCodelength == first.indexCodelength);
+}
+
+TEST_CASE("Exact small-module partitions match the sub-Infomap ones on nested cliques [core][flow]")
+{
+  // Groups of eight split into two cliques of four, so the recursive phase
+  // meets many modules small enough for --exact-small-modules. Their optimal
+  // split is clear enough that the sub-Infomap finds it too.
+  struct NestedRun {
+    std::map<unsigned int, unsigned int> leafModules;
+    unsigned int numLevels = 0;
+    double codelength = 0.0;
+  };
+  const auto run = [](const std::string& extraFlags) {
+    InfomapWrapper im(infomap::test::defaultFlags(extraFlags));
+    constexpr unsigned int numGroups = 60;
+    for (unsigned int group = 0; group < numGroups; ++group) {
+      const unsigned int base = group * 8;
+      for (unsigned int clique = 0; clique < 2; ++clique) {
+        for (unsigned int i = 0; i < 4; ++i) {
+          for (unsigned int j = i + 1; j < 4; ++j)
+            im.addLink(base + clique * 4 + i, base + clique * 4 + j, 1.0);
+        }
+      }
+      im.addLink(base + group % 4, base + 4 + (group + 1) % 4, 0.2);
+      im.addLink(base + 7, ((group + 1) % numGroups) * 8, 0.05);
+    }
+    im.run();
+    infomap::test::checkRunSanity(im);
+    return NestedRun { im.getModules(-1), im.numLevels(), im.codelength() };
+  };
+
+  const auto subInfomaps = run("");
+  const auto exact = run("--exact-small-modules");
+
+  CHECK(subInfomaps.numLevels > 3);
+  CHECK(exact.leafModules == subInfomaps.leafModules);
+  CHECK(exact.numLevels == subInfomaps.numLevels);
+  CHECK(exact.codelength == doctest::Approx(subInfomaps.codelength).epsilon(1e-10));
+}
+
+TEST_CASE("Recursive partition task grain does not change the result [core][flow][openmp]")
+{
+  // Every module is still partitioned by its own sub-Infomap seeded from the
+  // config, so how modules are grouped into tasks only changes the schedule.
+  const auto reference = runNoisyGroupNetwork("--num-threads 1");
+  for (const std::string grain : { "0", "16", "100000" }) {
+    INFO("grain=" << grain);
+    const auto batched = runNoisyGroupNetwork("--num-threads 4 --partition-task-grain " + grain);
+    CHECK(batched.modules == reference.modules);
+    CHECK(batched.codelength == reference.codelength);
+    CHECK(batched.indexCodelength == reference.indexCodelength);
+  }
+}
+
+TEST_CASE("Parallel super-module search is independent of the thread count under --deterministic [core][flow][openmp]")
+{
+  // The first level has 12000 modules, so the super network is large enough
+  // for the parallel sweep; the super levels must still compress about as well
+  // as the serial search.
+  const std::string flags = "--parallel-super-modules --deterministic";
+  const auto oneThread = runCliqueRingNetwork(flags + " --num-threads 1");
+  const auto fourThreads = runCliqueRingNetwork(flags + " --num-threads 4");
+  const auto reference = runCliqueRingNetwork("");
+
+  CHECK(oneThread.numTopModules > 1);
+  CHECK(oneThread.numTopModules < 12000);
+  CHECK(fourThreads.modules == oneThread.modules);
+  CHECK(fourThreads.codelength == oneThread.codelength);
+  CHECK(oneThread.codelength == doctest::Approx(reference.codelength).epsilon(0.01));
+}
+
+TEST_CASE("Parallel fine-tune is independent of the thread count under --deterministic [core][flow][openmp]")
+{
+  // The fine-tune only revisits leaves near modules that changed, so the result
+  // differs from the full sweep but must stay close to it in quality.
+  const std::string flags = "--tune-iteration-limit 4 --parallel-fine-tune --deterministic";
+  const auto oneThread = runNoisyGroupNetwork(flags + " --num-threads 1");
+  const auto fourThreads = runNoisyGroupNetwork(flags + " --num-threads 4");
+  const auto reference = runNoisyGroupNetwork("--tune-iteration-limit 4");
+
+  CHECK(oneThread.numTopModules > 1);
+  CHECK(fourThreads.modules == oneThread.modules);
+  CHECK(fourThreads.codelength == oneThread.codelength);
+  CHECK(oneThread.codelength == doctest::Approx(reference.codelength).epsilon(0.01));
+}
+
 TEST_CASE("Precomputed flow rejects first-order input without vertex flows [fast][core][flow][parser]")
 {
   InfomapWrapper im(infomap::test::defaultFlags("--flow-model precomputed"));
@@ -930,6 +1283,107 @@ TEST_CASE("Directed bipartite flow matches the same links without the bipartite
   CHECK(comparedNodes == 5);
 }
 
+TEST_CASE("Quadratic flow extrapolation needs fewer power iterations for the same flow [fast][core][flow]")
+{
+  struct AcceleratedFlow {
+    std::map<unsigned int, double> flows;
+    unsigned int iterations = 0;
+  };
+  const auto directedFlow = [](const std::string& acceleration) {
+    AcceleratedFlow result;
+    InfomapWrapper im(infomap::test::defaultFlags("--no-file-output --no-infomap --directed -p 0.02 --max-flow-iterations 2000 --flow-acceleration " + acceleration));
+    infomap::test::addNoisyGroupNetwork(im, 2000);
+    im.run();
+    for (auto it = im.iterLeafNodes(); !it.isEnd(); ++it)
+      result.flows[it->physicalId] = it->data.flow;
+    result.iterations = im.network().flowIterations();
+    return result;
+  };
+
+  const auto plain = directedFlow("none");
+  const auto quadratic = directedFlow("quadratic");
+
+  CHECK(plain.iterations < 2000);
+  CHECK(quadratic.iterations < plain.iterations);
+  REQUIRE(quadratic.flows.size() == plain.flows.size());
+  for (const auto& node : plain.flows)
+    CHECK(quadratic.flows.at(node.first) == doctest::Approx(node.second).epsilon(1e-10));
+}
+
+TEST_CASE("A warm start from an earlier run's flow needs fewer power iterations for the same flow [fast][core][flow]")
+{
+  struct WarmFlow {
+    std::map<unsigned int, double> flows;
+    unsigned int iterations = 0;
+  };
+  const std::string flags = infomap::test::defaultFlags("--no-file-output --no-infomap --directed -p 0.02 --max-flow-iterations 2000 --min-flow-iterations 1");
+  const auto directedFlow = [](InfomapWrapper& im) {
+    infomap::test::addNoisyGroupNetwork(im, 2000);
+    im.run();
+    WarmFlow result;
+    for (auto it = im.iterLeafNodes(); !it.isEnd(); ++it)
+      result.flows[it->physicalId] = it->data.flow;
+    result.iterations = im.network().flowIterations();
+    return result;
+  };
+
+  InfomapWrapper coldIm(flags);
+  const auto cold = directedFlow(coldIm);
+
+  // The reported flow is one teleportation-free step past the power iteration's
+  // fixed point; starting from it must land back on that fixed point.
+  InfomapWrapper warmIm(flags);
+  warmIm.network().setInitialFlow(cold.flows);
+  const auto warm = directedFlow(warmIm);
+
+  // The same start read from a clu file, as --initial-flow takes it.
+  const std::string cluPath = "warm_start_initial_flow.clu";
+  {
+    std::ofstream clu(cluPath);
+    clu << "# node_id module flow\n";
+    clu.precision(17);
+    for (const auto& node : cold.flows)
+      clu << node.first << " 1 " << node.second << "\n";
+  }
+  InfomapWrapper fileIm(flags + " --initial-flow " + cluPath);
+  const auto fromFile = directedFlow(fileIm);
+  std::remove(cluPath.c_str());
+
+  CHECK(cold.iterations < 2000);
+  CHECK(warm.iterations * 10 < cold.iterations);
+  CHECK(fromFile.iterations == warm.iterations);
+  REQUIRE(warm.flows.size() == cold.flows.size());
+  for (const auto& node : cold.flows) {
+    CHECK(warm.flows.at(node.first) == doctest::Approx(node.second).epsilon(1e-10));
+    CHECK(fromFile.flows.at(node.first) == warm.flows.at(node.first));
+  }
+}
+
+TEST_CASE("A warm start missing nodes counts its cold step as a power iteration [fast][core][flow]")
+{
+  const std::string flags = infomap::test::defaultFlags("--no-file-output --no-infomap --directed -p 0.02 --min-flow-iterations 5 --max-flow-iterations 5");
+  const auto flowIterations = [&](const std::map<unsigned int, double>& initialFlow) {
+    InfomapWrapper im(flags);
+    infomap::test::addNoisyGroupNetwork(im, 200);
+    im.network().setInitialFlow(initialFlow);
+    im.run();
+    return im.network().flowIterations();
+  };
+
+  std::map<unsigned int, double> initialFlow;
+  {
+    InfomapWrapper im(flags);
+    infomap::test::addNoisyGroupNetwork(im, 200);
+    im.run();
+    for (auto it = im.iterLeafNodes(); !it.isEnd(); ++it)
+      initialFlow[it->physicalId] = it->data.flow;
+  }
+
+  CHECK(flowIterations(initialFlow) == 5);
+  initialFlow.erase(initialFlow.begin());
+  CHECK(flowIterations(initialFlow) == 6);
+}
+
 TEST_CASE("Ordinary bipartite runs are unaffected by the flow post-condition [fast][core][flow]")
 {
   InfomapWrapper undirected(infomap::test::defaultFlags("-N 1 --seed 7"));
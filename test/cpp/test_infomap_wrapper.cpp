@@ -659,6 +659,50 @@ TEST_CASE("The summary report carries the power iteration's outcome [fast][core]
   removeFiles(paths);
 }
 
+TEST_CASE("A rerun with --flow-cache reads the flow instead of calculating it [fast][core][lifecycle][output][flow]")
+{
+  const std::string cacheDir = "flow_cache_test";
+  const std::vector<std::string> paths = {
+    "run_report_flow_cache_miss.json",
+    "run_report_flow_cache_hit.json",
+  };
+  removeFiles(paths);
+
+  const auto runOnce = [&](const std::string& summaryPath) {
+    std::unique_ptr<InfomapWrapper> im(new InfomapWrapper("--silent --seed 7 --directed --no-file-output --flow-cache " + cacheDir + " --summary-json " + summaryPath));
+    im->readInputData(infomap::test::repoPath("examples/networks/ninetriangles.net"));
+    im->run();
+    return im;
+  };
+
+  const auto miss = runOnce(paths[0]);
+  const auto cacheFile = miss->network().flowCacheFile();
+  REQUIRE_FALSE(cacheFile.empty());
+  CHECK_FALSE(miss->network().flowCacheHit());
+  CHECK(infomap::test::readTextFile(paths[0]).find("\"flow_cache\":{\"file\":\"" + cacheFile + "\",\"hit\":false}") != std::string::npos);
+
+  const auto hit = runOnce(paths[1]);
+  CHECK(hit->network().flowCacheFile() == cacheFile);
+  CHECK(hit->network().flowCacheHit());
+  const auto json = infomap::test::readTextFile(paths[1]);
+  CHECK(json.find("\"hit\":true") != std::string::npos);
+  // The power iteration's outcome travels with the cached flow.
+  CHECK(json.find("\"flow\":{\"converged\":true") != std::string::npos);
+  CHECK(hit->network().flowIterations() == miss->network().flowIterations());
+
+  // The same flow bit for bit, so the same partition and codelength.
+  CHECK(hit->codelength() == miss->codelength());
+  for (auto missIt = miss->iterLeafNodes(), hitIt = hit->iterLeafNodes(); !missIt.isEnd() && !hitIt.isEnd(); ++missIt, ++hitIt) {
+    CHECK(hitIt->stateId == missIt->stateId);
+    CHECK(hitIt->data.flow == missIt->data.flow);
+    CHECK(hitIt->data.enterFlow == missIt->data.enterFlow);
+    CHECK(hitIt->data.exitFlow == missIt->data.exitFlow);
+  }
+
+  removeFiles(paths);
+  removeFiles({ cacheFile, cacheDir });
+}
+
 TEST_CASE("Run reports write machine-readable JSON with no-file-output [fast][core][lifecycle][output]")
 {
   const std::vector<std::string> paths = {
@@ -706,6 +750,8 @@ TEST_CASE("Run reports write machine-readable JSON with no-file-output [fast][co
   CHECK(timingJson.find("\"seed\":8,") != std::string::npos);
   CHECK(timingJson.find("\"top_modules\":") != std::string::npos);
   CHECK(timingJson.find("\"num_levels\":") != std::string::npos);
+  CHECK(timingJson.find("\"sub_infomaps\":{\"instances\":") != std::string::npos);
+  CHECK(timingJson.find("\"partition_tasks\":{\"created\":") != std::string::npos);
   CHECK(timingJson.find("\"memory\":{\"rss_peak_mb\":") != std::string::npos);
 
   removeFiles(paths);
@@ -858,6 +904,86 @@ TEST_CASE("Parallel trials with entropy correction match serial trials [fast][co
 #endif
 }
 
+TEST_CASE("Parallel-trial workers that run several trials match the serial trials [fast][core][lifecycle][openmp]")
+{
+#ifdef _OPENMP
+  // Two workers share six trials, reusing their leaf network between them.
+  const auto run = [](const std::string& flags, bool hard) {
+    InfomapWrapper im("--silent --no-file-output --seed 7 --num-trials 6 " + flags);
+    im.readInputData(infomap::test::repoPath("examples/networks/ninetriangles.net"));
+    if (hard) {
+      std::map<unsigned int, unsigned int> pairs;
+      for (unsigned int nodeId = 1; nodeId <= 27; ++nodeId)
+        pairs[nodeId] = (nodeId - 1) / 2;
+      im.setInitialPartition(pairs);
+      im.clusterDataIsHard = true;
+    }
+    im.run();
+    infomap::test::checkRunSanity(im);
+    return im.codelengths();
+  };
+  for (bool hard : { false, true }) {
+    CAPTURE(hard);
+    const auto parallel = run("--parallel-trials --num-threads 2", hard);
+    const auto serial = run("", hard);
+    REQUIRE(parallel.size() == serial.size());
+    for (unsigned int i = 0; i < serial.size(); ++i)
+      CHECK(parallel[i] == doctest::Approx(serial[i]));
+  }
+#endif
+}
+
+TEST_CASE("Parallel-trial workers with threads to spare match the serial trials [fast][core][lifecycle][openmp]")
+{
+#ifdef _OPENMP
+  // Two workers with two threads each, and all five for the one left once the
+  // other runs out of trials. The recursive partition runs on the nested teams,
+  // and under --deterministic so does the parallel move sweep.
+  const auto run = [](const std::string& flags) {
+    InfomapWrapper im("--silent --no-file-output --seed 7 --num-trials 2 " + flags);
+    infomap::test::addNoisyGroupNetwork(im);
+    im.run();
+    infomap::test::checkRunSanity(im);
+    return im.codelengths();
+  };
+  for (const std::string mode : { "", "--inner-parallelization --deterministic" }) {
+    CAPTURE(mode);
+    const auto parallel = run("--parallel-trials --num-threads 5 " + mode);
+    const auto serial = run("--num-threads 1 " + mode);
+    REQUIRE(parallel.size() == serial.size());
+    for (unsigned int i = 0; i < serial.size(); ++i)
+      CHECK(parallel[i] == doctest::Approx(serial[i]).epsilon(1e-12));
+  }
+#endif
+}
+
+TEST_CASE("Parallel trials on a hard initial partition match serial trials [fast][core][lifecycle][openmp]")
+{
+#ifdef _OPENMP
+  // A hard partition swaps the leaf network for its modules, which an adjacency
+  // cached before the swap does not describe.
+  const auto run = [](const std::string& flags) {
+    InfomapWrapper im("--silent --no-file-output " + flags);
+    im.readInputData(infomap::test::repoPath("examples/networks/ninetriangles.net"));
+    std::map<unsigned int, unsigned int> pairs;
+    for (unsigned int nodeId = 1; nodeId <= 27; ++nodeId)
+      pairs[nodeId] = (nodeId - 1) / 2;
+    im.setInitialPartition(pairs);
+    im.clusterDataIsHard = true;
+    im.run();
+    infomap::test::checkRunSanity(im);
+    return im.codelengths();
+  };
+  const auto codelengths = run("--seed 7 --num-trials 4 --parallel-trials");
+  REQUIRE(codelengths.size() == 4);
+  for (unsigned int i = 0; i < codelengths.size(); ++i) {
+    const auto serial = run("--seed " + std::to_string(7 + i) + " --num-trials 1");
+    REQUIRE(serial.size() == 1);
+    CHECK(codelengths[i] == doctest::Approx(serial[0]));
+  }
+#endif
+}
+
 TEST_CASE("Parallel trials with variable Markov time are invariant to worker count [fast][core][lifecycle][openmp]")
 {
 #ifdef _OPENMP
@@ -900,7 +1026,8 @@ TEST_CASE("Parallel trials warn when inner parallelization is requested [fast][c
 {
 #ifdef _OPENMP
   LogCapture capture;
-  InfomapWrapper im("--seed 7 --num-trials 2 --parallel-trials --inner-parallelization --no-file-output");
+  // One thread per worker, so none is left for the inner parallelization.
+  InfomapWrapper im("--seed 7 --num-trials 2 --num-threads 2 --parallel-trials --inner-parallelization --no-file-output");
   infomap::test::addEdgeFixtureLinks(im, "graphs/twotriangles_unweighted.edges");
 
   im.run();
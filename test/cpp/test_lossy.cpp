@@ -224,6 +224,51 @@ TEST_CASE("Lossy: noiseTopModules reports which top modules are noise [fast][cor
   CHECK(lump.noiseTopModules() == std::vector<unsigned int> { 1 });
 }
 
+namespace {
+
+// Blocks of a 5-clique and a 5-node chain hanging off it, joined in a ring:
+// large enough for the parallel move sweep, with both standard and noise
+// modules in the optimum at lambda 2.5.
+void addCliqueChainRing(InfomapWrapper& im, unsigned int numBlocks = 1200)
+{
+  constexpr unsigned int blockSize = 10;
+  const unsigned int numNodes = numBlocks * blockSize;
+  for (unsigned int block = 0; block < numBlocks; ++block) {
+    const unsigned int first = block * blockSize;
+    for (unsigned int i = 0; i < 5; ++i) {
+      for (unsigned int j = i + 1; j < 5; ++j)
+        im.addLink(first + i, first + j);
+    }
+    for (unsigned int i = 4; i < blockSize - 1; ++i)
+      im.addLink(first + i, first + i + 1);
+    im.addLink(first + blockSize - 1, (first + blockSize) % numNodes);
+  }
+}
+
+} // namespace
+
+TEST_CASE("Lossy: inner parallelization stays close to the serial sweep [core][lossy][openmp]")
+{
+  const auto run = [](const std::string& flags) {
+    auto im = std::make_unique<InfomapWrapper>(defaultFlags("--lossy --lambda 2.5 " + flags));
+    addCliqueChainRing(*im);
+    im->run();
+    checkRunSanity(*im);
+    return im;
+  };
+  const auto serial = run("");
+  const auto inner = run("--inner-parallelization --num-threads 4");
+
+  CHECK(inner->numTopModules() > 1);
+  CHECK(inner->codelength() < serial->codelength() * 1.02);
+  CHECK(inner->getLossyDistortion() > 0.0);
+  CHECK(inner->codelength() == doctest::Approx(inner->getLossyRate() + inner->lossyLambda * inner->getLossyDistortion()).epsilon(1e-9));
+
+  const auto again = run("--inner-parallelization --num-threads 4");
+  CHECK(canonicalPartition(again->getModules()) == canonicalPartition(inner->getModules()));
+  CHECK(again->codelength() == inner->codelength());
+}
+
 } // namespace test
 } // namespace infomap
 
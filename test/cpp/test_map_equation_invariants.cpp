@@ -1,4 +1,5 @@
 #include "TestUtils.h"
+#include "core/MapEquation.h"
 
 #include <cmath>
 
@@ -55,6 +56,20 @@ TEST_CASE("MapEquation invariant: MemMapEquation (memory), tracked == recompute
   checkTrackedMatchesRecompute(im);
 }
 
+TEST_CASE("MapEquation invariant: MemMapEquation under inner parallelization, tracked == recompute [core][mapeq][mem][openmp]")
+{
+  // The parallel sweep rechecks a proposal against the physical-node map as
+  // committed so far; a recheck that dropped the memory terms would leave the
+  // tracked codelength behind the partition it describes. Large enough to take
+  // the parallel path, with an explicit thread budget for the same reason, and
+  // stopped after the leaf-level sweeps: every later level re-initialises the
+  // codelength terms from scratch and would hide the drift.
+  InfomapWrapper im(defaultFlags("--two-level --directed --core-level-limit 1 --tune-iteration-limit 1 --inner-parallelization --num-threads 4"));
+  addOverlappingStateNetwork(im);
+  im.run();
+  checkTrackedMatchesRecompute(im);
+}
+
 TEST_CASE("MapEquation invariant: MetaMapEquation (meta-data), tracked == recompute [fast][core][mapeq][meta]")
 {
   // states_crossing.meta on purpose, not states.meta: the latter's categories
@@ -78,6 +93,85 @@ TEST_CASE("MapEquation invariant: MetaMapEquation (meta-data), tracked == recomp
   checkTrackedMatchesRecompute(im);
 }
 
+TEST_CASE("MapEquation invariant: MetaMapEquation under inner parallelization, tracked == recompute [core][mapeq][meta][openmp]")
+{
+  // Proposals evaluate the meta term read-only against the sweep-start
+  // collections and the commit applies it; stopped after the leaf-level sweeps
+  // as in the memory case above.
+  InfomapWrapper im(defaultFlags("--two-level --core-level-limit 1 --tune-iteration-limit 1 --inner-parallelization --num-threads 4"));
+  addMetaDataGroupNetwork(im);
+  im.run();
+  CHECK(im.getMetaCodelength() > 0.0);
+  checkTrackedMatchesRecompute(im);
+}
+
+TEST_CASE("MapEquation invariant: BiasedMapEquation under the coloring sweep, tracked == recompute [core][mapeq][biased][openmp]")
+{
+  // A color's moves are applied together and the codelength terms of the
+  // modules they changed replaced in one pass; a term left out of that pass
+  // would drift here. Stopped after the leaf-level sweeps as above.
+  InfomapWrapper im(defaultFlags("--two-level --core-level-limit 1 --tune-iteration-limit 1 --inner-parallelization --inner-parallel-strategy coloring --num-threads 4"));
+  addNoisyGroupNetwork(im);
+  im.run();
+  checkTrackedMatchesRecompute(im);
+}
+
+TEST_CASE("MapEquation invariant: MemMapEquation under active-set parallel sweeps, tracked == recompute [core][mapeq][mem][openmp]")
+{
+  // The active set keeps the empty-module stack from the moves instead of a
+  // rescan; a stale entry would offer a module that is not empty and corrupt
+  // the tracked terms. Memory input, so the sweep also goes through the
+  // physical-node recheck.
+  InfomapWrapper im(defaultFlags("--two-level --directed --core-level-limit 1 --tune-iteration-limit 1 --inner-parallelization --active-set --num-threads 4"));
+  addOverlappingStateNetwork(im);
+  im.run();
+  checkTrackedMatchesRecompute(im);
+}
+
+TEST_CASE("MapEquation invariant: batched move delta == per-candidate delta [fast][core][mapeq]")
+{
+  // The move loop scores all candidates of a node in one batch, with the
+  // old-module terms hoisted. Each entry must match the unhoisted delta of the
+  // same move: exactly on the scalar build, to the last few ulps where the
+  // SIMD log regroups the lanes. Uneven module flows and a candidate count
+  // that is not a multiple of any SIMD width.
+  MapEquation<> objective;
+  objective.enterFlow = 0.55;
+  objective.enterFlow_log_enterFlow = infomath::plogp(objective.enterFlow);
+
+  std::vector<FlowData> moduleFlowData(7);
+  for (unsigned int m = 0; m < moduleFlowData.size(); ++m) {
+    moduleFlowData[m].flow = 0.05 + 0.02 * m;
+    moduleFlowData[m].enterFlow = 0.03 + 0.011 * m;
+    moduleFlowData[m].exitFlow = 0.02 + 0.013 * m;
+  }
+  std::vector<unsigned int> moduleMembers(moduleFlowData.size(), 3);
+
+  FlowData nodeData(0.04);
+  nodeData.enterFlow = 0.015;
+  nodeData.exitFlow = 0.012;
+  InfoNode current(nodeData);
+  current.index = 2;
+
+  DeltaFlow oldModuleDelta(2, 0.004, 0.003);
+  std::vector<DeltaFlow> candidates;
+  for (unsigned int m = 0; m < moduleFlowData.size(); ++m) {
+    if (m != current.index)
+      candidates.emplace_back(m, 0.001 * m, 0.0015 * m);
+  }
+
+  const auto oldSide = objective.hoistOldSide(current, oldModuleDelta, moduleFlowData);
+  DeltaBatchScratch batch;
+  objective.getDeltaCodelengthOnMovingNodeBatch(current, oldModuleDelta, oldSide, candidates.data(), static_cast<unsigned int>(candidates.size()), moduleFlowData, moduleMembers, batch);
+  REQUIRE(batch.deltas.size() == candidates.size());
+
+  for (std::size_t j = 0; j < candidates.size(); ++j) {
+    const double single = objective.getDeltaCodelengthOnMovingNode(current, oldModuleDelta, candidates[j], moduleFlowData, moduleMembers);
+    INFO("candidate module " << candidates[j].module);
+    checkApproxCodelength(batch.deltas[j], single, 1e-12);
+  }
+}
+
 #if INFOMAP_FEATURE_REGULARIZED_MULTILAYER
 TEST_CASE("MapEquation invariant: RegularizedMultilayerMapEquation, tracked == recompute [fast][core][mapeq][regularized]")
 {
@@ -87,6 +181,15 @@ TEST_CASE("MapEquation invariant: RegularizedMultilayerMapEquation, tracked == r
   im.run();
   checkTrackedMatchesRecompute(im);
 }
+
+TEST_CASE("MapEquation invariant: RegularizedMultilayerMapEquation under inner parallelization, tracked == recompute [core][mapeq][regularized][openmp]")
+{
+  // As for the memory case, with the layer teleportation state applied at commit.
+  InfomapWrapper im(defaultFlags("--two-level --directed --regularized --core-level-limit 1 --tune-iteration-limit 1 --inner-parallelization --num-threads 4"));
+  addShiftedGroupMultilayerNetwork(im);
+  im.run();
+  checkTrackedMatchesRecompute(im);
+}
 #endif
 
 // Regression for #830: under --entropy-corrected the tracked codelength drifts
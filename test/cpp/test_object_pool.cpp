@@ -82,3 +82,19 @@ TEST_CASE("ObjectPool first chunk is small, growth is geometric")
   CHECK(pool.chunkCount() == 1);
   pool.free(p); // pool must be empty at teardown (contract enforced by assert)
 }
+
+TEST_CASE("ObjectPool capacity keeps freed slots")
+{
+  ObjectPool<Probe> pool;
+  CHECK(pool.capacity() == 0);
+  pool.reserve(10);
+  CHECK(pool.capacity() == 10);
+  std::vector<Probe*> live;
+  for (int i = 0; i < 10; ++i)
+    live.push_back(pool.alloc(i));
+  CHECK(pool.capacity() == 10);
+  for (Probe* p : live)
+    pool.free(p);
+  CHECK(pool.liveCount() == 0);
+  CHECK(pool.capacity() == 10);
+}
@@ -14,6 +14,7 @@
 #include "TestUtils.h"
 
 #include <cstdio>
+#include <random>
 #include <set>
 #include <string>
 #include <utility>
@@ -160,3 +161,116 @@ TEST_CASE("Shard run emits trial-results JSON and best-tree file; --no-final-out
   std::remove(trialTree6.c_str());
   std::remove(aggregatePath.c_str());
 }
+
+TEST_CASE("--prune-trials abandons trials behind the best and marks them in the trial results [fast][core][merge][openmp]")
+{
+#ifdef _OPENMP
+  // One worker runs the trials in order, so which ones are abandoned is fixed.
+  const std::string resultsPath = "tr_prune_trials.json";
+  std::remove(resultsPath.c_str());
+
+  auto runCycle = [&resultsPath](const std::string& extraFlags) {
+    InfomapWrapper im("--silent --no-file-output --seed 3 --num-trials 8 --parallel-trials --num-threads 1 --trial-results " + resultsPath + " " + extraFlags);
+    for (unsigned int i = 0; i < 60; ++i) {
+      im.addLink(i, (i + 1) % 60);
+    }
+    im.run();
+    return std::make_pair(im.codelengths(), im.codelength());
+  };
+
+  const auto full = runCycle("");
+  REQUIRE(full.first.size() == 8);
+  CHECK(readTextFile(resultsPath).find("\"abandoned\":true") == std::string::npos);
+
+  SUBCASE("a wide margin keeps every trial")
+  {
+    const auto pruned = runCycle("--prune-trials --prune-trials-margin 0.05");
+    CHECK(pruned.first == full.first);
+    CHECK(readTextFile(resultsPath).find("\"abandoned\":true") == std::string::npos);
+  }
+
+  SUBCASE("no margin abandons the trials behind at a checkpoint and only those")
+  {
+    const auto pruned = runCycle("--prune-trials --prune-trials-margin 0");
+    REQUIRE(pruned.first.size() == 8);
+    // The first trial sets the best two-level codelength, so it always finishes.
+    CHECK(pruned.first[0] == doctest::Approx(full.first[0]));
+
+    // An abandoned trial records the codelength where it stopped; the others
+    // run exactly as without pruning.
+    std::size_t numChanged = 0;
+    for (std::size_t i = 0; i < pruned.first.size(); ++i) {
+      if (pruned.first[i] != doctest::Approx(full.first[i]))
+        ++numChanged;
+    }
+    const auto json = readTextFile(resultsPath);
+    std::size_t numAbandoned = 0;
+    for (auto pos = json.find("\"abandoned\":true"); pos != std::string::npos; pos = json.find("\"abandoned\":true", pos + 1))
+      ++numAbandoned;
+    CHECK(numAbandoned > 0);
+    CHECK(numAbandoned == numChanged);
+  }
+
+  std::remove(resultsPath.c_str());
+#endif
+}
+
+TEST_CASE("--prune-trials does not abandon a later trial that wins after the hierarchy [fast][core][merge][openmp]")
+{
+#ifdef _OPENMP
+  // Six groups of six modules of eight nodes, with some noise. The hierarchy
+  // takes more than the default margin off the two-level codelength, and the
+  // fifth trial wins, so comparing its two-level codelength with the first
+  // finished trial's hierarchical one would abandon it.
+  auto runNested = [](const std::string& extraFlags) {
+    InfomapWrapper im("--silent --no-file-output --seed 2 --num-trials 8 --parallel-trials --num-threads 1 " + extraFlags);
+    std::mt19937 rng(3);
+    const auto draw = [&rng](unsigned int n) { return static_cast<unsigned int>(rng() % n); };
+    const auto id = [](unsigned int group, unsigned int module, unsigned int node) { return group * 48 + module * 8 + node; };
+    const auto link = [&im](unsigned int source, unsigned int target) {
+      if (source != target)
+        im.addLink(source, target);
+    };
+    for (unsigned int group = 0; group < 6; ++group) {
+      for (unsigned int module = 0; module < 6; ++module) {
+        for (unsigned int i = 0; i < 8; ++i) {
+          for (unsigned int j = i + 1; j < 8; ++j) {
+            if (draw(10) < 7)
+              link(id(group, module, i), id(group, module, j));
+          }
+        }
+        for (unsigned int other = module + 1; other < 6; ++other) {
+          for (unsigned int k = 0; k < 2; ++k) {
+            const auto source = id(group, module, draw(8));
+            link(source, id(group, other, draw(8)));
+          }
+        }
+      }
+      for (unsigned int other = group + 1; other < 6; ++other) {
+        const auto source = id(group, draw(6), draw(8));
+        link(source, id(other, draw(6), draw(8)));
+      }
+    }
+    for (unsigned int k = 0; k < 120; ++k) {
+      const auto source = draw(288);
+      link(source, draw(288));
+    }
+    im.run();
+    return std::make_pair(im.codelengths(), im.codelength());
+  };
+
+  const auto full = runNested("");
+  REQUIRE(full.first.size() == 8);
+  std::size_t winner = 0;
+  for (std::size_t i = 1; i < full.first.size(); ++i) {
+    if (full.first[i] < full.first[winner])
+      winner = i;
+  }
+  CHECK(winner > 0);
+
+  const auto pruned = runNested("--prune-trials");
+  REQUIRE(pruned.first.size() == 8);
+  CHECK(pruned.first[winner] == doctest::Approx(full.first[winner]));
+  CHECK(pruned.second == doctest::Approx(full.second));
+#endif
+}
@@ -109,6 +109,27 @@ def test_merge_ties_break_on_lowest_global_index(tmp_path):
     assert summary["trial"] == 0  # equal codelength -> lowest global index wins
 
 
+def test_merge_skips_abandoned_trials(tmp_path):
+    # A trial abandoned by --prune-trials records the codelength it stopped at
+    # and has no tree of its own, so it must not win even when that is lowest.
+    path = _shard(
+        tmp_path,
+        "a",
+        offset=0,
+        trials=[(0, 6.5), (1, 6.0)],
+        best_tree_modules={1: 1, 2: 1},
+    )
+    data = json.loads(Path(path).read_text(encoding="utf-8"))
+    data["trials"][1]["abandoned"] = True
+    Path(path).write_text(json.dumps(data), encoding="utf-8")
+    _shard(tmp_path, "b", offset=2, trials=[(2, 6.3)], best_tree_modules={1: 2, 2: 2})
+    summary = merge_trial_results(
+        [str(tmp_path / "*.json")], out_name=str(tmp_path / "out")
+    )
+    assert summary["trial"] == 2
+    assert summary["codelength"] == pytest.approx(6.3)
+
+
 def test_merge_refuses_config_fingerprint_mismatch(tmp_path):
     _shard(
         tmp_path,